@@ -0,0 +1,250 @@
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+
+// Measures message::append and message::read for the common D-Bus types,
+// on in-memory messages, so no broker is needed.
+//
+//     - BM_New: creating an empty method call, which every BM_Append
+//       iteration includes, for reference.
+//     - BM_Append/<type>: creating a message and appending a value.
+//     - BM_Read/<type>: rewinding a sealed message and reading the value.
+//
+// Container benchmarks take the number of elements as their argument;
+// a{sa{sv}} takes the number of interfaces, each with 8 properties.
+
+namespace message = sdbusplus::message;
+
+/** A bus on one end of a socketpair, which is enough to create messages. */
+struct Bus
+{
+    Bus()
+    {
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+
+        sd_bus* b = nullptr;
+        sd_bus_new(&b);
+        sd_bus_set_fd(b, fds[0], fds[0]);
+        sd_bus_start(b);
+        bus = std::make_unique<sdbusplus::bus::bus>(b, std::false_type());
+    }
+
+    ~Bus()
+    {
+        // Close the peer first, so the flush on release does not wait for
+        // it to finish authentication.
+        close(fds[1]);
+        bus.reset();
+    }
+
+    auto newMethodCall()
+    {
+        return bus->new_method_call("xyz.openbmc_project.sdbusplus.bench",
+                                    "/xyz/openbmc_project/sdbusplus/bench",
+                                    "xyz.openbmc_project.sdbusplus.bench",
+                                    "Marshal");
+    }
+
+    int fds[2];
+    std::unique_ptr<sdbusplus::bus::bus> bus;
+};
+
+using properties_t = std::map<std::string,
+                              message::variant<int64_t, std::string, bool,
+                                               double>>;
+using interfaces_t = std::map<std::string, properties_t>;
+
+/** Create the value to marshal, with 'n' elements for containers. */
+template <typename T>
+struct make
+{
+    static T value(size_t) { return T{}; }
+};
+
+template <>
+struct make<int32_t>
+{
+    static int32_t value(size_t) { return 42; }
+};
+
+template <>
+struct make<uint64_t>
+{
+    static uint64_t value(size_t) { return 0x123456789abcdefull; }
+};
+
+template <>
+struct make<double>
+{
+    static double value(size_t) { return 3.14159; }
+};
+
+template <>
+struct make<bool>
+{
+    static bool value(size_t) { return true; }
+};
+
+template <>
+struct make<std::string>
+{
+    static std::string value(size_t n) { return std::string(n, 'x'); }
+};
+
+template <>
+struct make<message::object_path>
+{
+    static message::object_path value(size_t n)
+    {
+        return { "/xyz/openbmc_project/inventory/system/chassis/item" +
+                 std::to_string(n) };
+    }
+};
+
+template <typename T>
+struct make<std::vector<T>>
+{
+    static std::vector<T> value(size_t n)
+    {
+        std::vector<T> v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(make<T>::value(i % 16));
+        }
+        return v;
+    }
+};
+
+template <>
+struct make<interfaces_t>
+{
+    static interfaces_t value(size_t n)
+    {
+        interfaces_t v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto& p = v["xyz.openbmc_project.Interface" + std::to_string(i)];
+            p["Int0"] = int64_t(i);
+            p["Int1"] = int64_t(i * 2);
+            p["Name"] = std::string("name");
+            p["Description"] = std::string(64, 'd');
+            p["Present"] = true;
+            p["Functional"] = false;
+            p["Value"] = 1.5;
+            p["Max"] = 100.0;
+        }
+        return v;
+    }
+};
+
+template <typename... Args>
+struct make<std::tuple<Args...>>
+{
+    static std::tuple<Args...> value(size_t)
+    {
+        return std::make_tuple(make<Args>::value(8)...);
+    }
+};
+
+template <typename... Args>
+struct make<message::variant<Args...>>
+{
+    // Hold the last alternative, so reading tries every type before it.
+    static message::variant<Args...> value(size_t)
+    {
+        using last = typename std::tuple_element<
+                sizeof...(Args) - 1, std::tuple<Args...>>::type;
+        return make<last>::value(8);
+    }
+};
+
+static void BM_New(benchmark::State& state)
+{
+    Bus b;
+    for (auto _ : state)
+    {
+        auto m = b.newMethodCall();
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_New);
+
+template <typename T>
+static void BM_Append(benchmark::State& state)
+{
+    Bus b;
+    auto value = make<T>::value(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto m = b.newMethodCall();
+        m.append(value);
+        benchmark::DoNotOptimize(m);
+    }
+}
+
+template <typename T>
+static void BM_Read(benchmark::State& state)
+{
+    Bus b;
+    auto m = b.newMethodCall();
+    m.append(make<T>::value(state.range(0)));
+
+    auto sealed = sd_bus_message_ref(m.release());
+    sd_bus_message_seal(sealed, 1, 0);
+    message::message msg(sealed, std::false_type());
+
+    for (auto _ : state)
+    {
+        sd_bus_message_rewind(sealed, true);
+        T value{};
+        msg.read(value);
+        benchmark::DoNotOptimize(value);
+    }
+
+    sd_bus_message_unref(sealed);
+}
+
+using tuple1_t = std::tuple<int32_t>;
+using tuple4_t = std::tuple<int32_t, std::string, double, bool>;
+using tuple8_t = std::tuple<int32_t, std::string, double, bool, uint64_t,
+                            message::object_path, std::string, int32_t>;
+using variant2_t = message::variant<int32_t, std::string>;
+using variant4_t = message::variant<int32_t, double, bool, std::string>;
+using variant8_t = message::variant<int32_t, uint64_t, double, bool,
+                                    message::object_path,
+                                    std::vector<int32_t>,
+                                    std::vector<std::string>, std::string>;
+
+#define MARSHAL_BENCHMARK(T, ...) \
+    BENCHMARK_TEMPLATE(BM_Append, T)->__VA_ARGS__; \
+    BENCHMARK_TEMPLATE(BM_Read, T)->__VA_ARGS__
+
+MARSHAL_BENCHMARK(int32_t, Arg(0));
+MARSHAL_BENCHMARK(uint64_t, Arg(0));
+MARSHAL_BENCHMARK(double, Arg(0));
+MARSHAL_BENCHMARK(bool, Arg(0));
+MARSHAL_BENCHMARK(std::string, Arg(8)->Arg(256));
+MARSHAL_BENCHMARK(message::object_path, Arg(0));
+MARSHAL_BENCHMARK(std::vector<uint8_t>, Arg(16)->Arg(1024)->Arg(16384));
+MARSHAL_BENCHMARK(std::vector<int32_t>, Arg(16)->Arg(1024)->Arg(16384));
+MARSHAL_BENCHMARK(std::vector<double>, Arg(16)->Arg(1024));
+MARSHAL_BENCHMARK(std::vector<std::string>, Arg(16)->Arg(1024));
+MARSHAL_BENCHMARK(std::vector<message::object_path>, Arg(16)->Arg(1024));
+MARSHAL_BENCHMARK(interfaces_t, Arg(1)->Arg(16));
+MARSHAL_BENCHMARK(tuple1_t, Arg(0));
+MARSHAL_BENCHMARK(tuple4_t, Arg(0));
+MARSHAL_BENCHMARK(tuple8_t, Arg(0));
+MARSHAL_BENCHMARK(variant2_t, Arg(0));
+MARSHAL_BENCHMARK(variant4_t, Arg(0));
+MARSHAL_BENCHMARK(variant8_t, Arg(0));
+
+BENCHMARK_MAIN();
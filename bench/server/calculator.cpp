@@ -0,0 +1,308 @@
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server.hpp>
+#include <net/poettering/Calculator/server.hpp>
+#include <net/poettering/Calculator/error.hpp>
+
+// Measures the example Calculator end to end: the client makes calls with
+// bus::call() to a server running the generated bindings on its own thread.
+//
+//     - BM_Multiply, BM_DivideByZero, BM_Get, BM_GetAll, BM_Set: a method
+//       call, a method call failing with a generated error, and the three
+//       property methods, over a private peer-to-peer connection, so the
+//       numbers do not include the broker.  Besides the time per call and
+//       calls per second (items_per_second), these report the 50th and 99th
+//       percentile latency of a single call, in nsec.
+//     - BM_SignalFanout/<n>: emitting the Cleared signal and waiting until
+//       each of 'n' subscribers has received it.  This needs the broker,
+//       which does the fan-out.
+//
+// Use '--benchmark_format=json', or '--benchmark_out=<file>', to get the
+// results in a form which can be compared between releases.
+
+using Calculator_inherit = sdbusplus::server::object_t<
+        sdbusplus::net::poettering::server::Calculator>;
+
+static constexpr auto path = "/net/poettering/calculator";
+static constexpr auto interf = "net.poettering.Calculator";
+
+/** The example implementation of net.poettering.Calculator. */
+struct Calculator : Calculator_inherit
+{
+    Calculator(sdbusplus::bus::bus& bus, const char* path) :
+        Calculator_inherit(bus, path) { }
+
+    int64_t multiply(int64_t x, int64_t y) override
+    {
+        return lastResult(x*y);
+    }
+
+    int64_t divide(int64_t x, int64_t y) override
+    {
+        using sdbusplus::net::poettering::Calculator::Error::DivisionByZero;
+        if (y == 0)
+        {
+            status(State::Error);
+            throw DivisionByZero();
+        }
+
+        return lastResult(x/y);
+    }
+
+    void clear() override
+    {
+        auto v = lastResult();
+        lastResult(0);
+        cleared(v);
+    }
+};
+
+/** A Calculator served on its own thread, over a socketpair to a client. */
+class Server
+{
+    public:
+        Server()
+        {
+            int fds[2];
+            socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+
+            sd_id128_t id;
+            sd_id128_randomize(&id);
+
+            sd_bus* b = nullptr;
+            sd_bus_new(&b);
+            sd_bus_set_fd(b, fds[0], fds[0]);
+            sd_bus_set_server(b, 1, id);
+            sd_bus_start(b);
+            bus = std::make_unique<sdbusplus::bus::bus>(b, std::false_type());
+
+            sd_bus_new(&clientp);
+            sd_bus_set_fd(clientp, fds[1], fds[1]);
+            sd_bus_start(clientp);
+            client = std::make_unique<sdbusplus::bus::bus>(
+                    clientp, std::false_type());
+
+            calculator = std::make_unique<Calculator>(*bus, path);
+
+            thread = std::thread([this]
+                {
+                    while (!stop)
+                    {
+                        bus->wait(10000);
+                        bus->process_discard();
+                    }
+                });
+        }
+
+        ~Server()
+        {
+            stop = true;
+            thread.join();
+            calculator.reset();
+            client.reset();
+        }
+
+        /** Create a method call to the server, from the client. */
+        auto newMethodCall(const char* interface, const char* method)
+        {
+            return client->new_method_call(nullptr, path, interface, method);
+        }
+
+        std::unique_ptr<sdbusplus::bus::bus> bus;
+        std::unique_ptr<sdbusplus::bus::bus> client;
+        sd_bus* clientp = nullptr;
+
+    private:
+        std::unique_ptr<Calculator> calculator;
+        std::atomic<bool> stop{false};
+        std::thread thread;
+};
+
+/** Make calls until the benchmark ends, and report latency percentiles.
+ *
+ *  @param[in] state - The benchmark state.
+ *  @param[in] server - The server to make calls to.
+ *  @param[in] call - A function making one call.
+ */
+template <typename Call>
+static void calls(benchmark::State& state, Server& server, Call&& call)
+{
+    std::vector<uint64_t> latency;
+    latency.reserve(1 << 16);
+
+    for (auto _ : state)
+    {
+        auto start = std::chrono::steady_clock::now();
+        call(server);
+        auto end = std::chrono::steady_clock::now();
+
+        latency.push_back(std::chrono::duration_cast<
+                std::chrono::nanoseconds>(end - start).count());
+
+        // Drop the PropertiesChanged signals the calls cause, which the
+        // client queues while waiting for its replies.
+        if ((latency.size() % 64) == 0)
+        {
+            state.PauseTiming();
+            while (sd_bus_process(server.clientp, nullptr) > 0)
+            {
+            }
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (!latency.empty())
+    {
+        std::sort(latency.begin(), latency.end());
+        state.counters["p50_ns"] = latency[latency.size() / 2];
+        state.counters["p99_ns"] = latency[latency.size() * 99 / 100];
+    }
+}
+
+static void BM_Multiply(benchmark::State& state)
+{
+    Server server;
+    calls(state, server, [](Server& s)
+        {
+            auto m = s.newMethodCall(interf, "Multiply");
+            m.append(int64_t(7), int64_t(6));
+            auto reply = s.client->call(m);
+
+            int64_t z = 0;
+            reply.read(z);
+            benchmark::DoNotOptimize(z);
+        });
+}
+BENCHMARK(BM_Multiply)->UseRealTime();
+
+static void BM_DivideByZero(benchmark::State& state)
+{
+    Server server;
+    calls(state, server, [](Server& s)
+        {
+            auto m = s.newMethodCall(interf, "Divide");
+            m.append(int64_t(7), int64_t(0));
+            auto reply = s.client->call(m);
+            benchmark::DoNotOptimize(reply);
+        });
+}
+BENCHMARK(BM_DivideByZero)->UseRealTime();
+
+static void BM_Get(benchmark::State& state)
+{
+    Server server;
+    calls(state, server, [](Server& s)
+        {
+            auto m = s.newMethodCall("org.freedesktop.DBus.Properties",
+                                     "Get");
+            m.append(interf, "LastResult");
+            auto reply = s.client->call(m);
+
+            sdbusplus::message::variant<int64_t> value;
+            reply.read(value);
+            benchmark::DoNotOptimize(value);
+        });
+}
+BENCHMARK(BM_Get)->UseRealTime();
+
+static void BM_GetAll(benchmark::State& state)
+{
+    Server server;
+    calls(state, server, [](Server& s)
+        {
+            auto m = s.newMethodCall("org.freedesktop.DBus.Properties",
+                                     "GetAll");
+            m.append(interf);
+            auto reply = s.client->call(m);
+            benchmark::DoNotOptimize(reply);
+        });
+}
+BENCHMARK(BM_GetAll)->UseRealTime();
+
+static void BM_Set(benchmark::State& state)
+{
+    Server server;
+    int64_t i = 0;
+    calls(state, server, [&i](Server& s)
+        {
+            auto m = s.newMethodCall("org.freedesktop.DBus.Properties",
+                                     "Set");
+            m.append(interf, "LastResult",
+                     sdbusplus::message::variant<int64_t>(++i));
+            s.client->call(m);
+        });
+}
+BENCHMARK(BM_Set)->UseRealTime();
+
+static void BM_SignalFanout(benchmark::State& state)
+{
+    namespace rules = sdbusplus::bus::match::rules;
+
+    auto bus = sdbusplus::bus::new_default();
+    Calculator calculator(bus, path);
+
+    struct Subscriber
+    {
+        Subscriber() :
+            bus(sdbusplus::bus::new_default()),
+            match(bus,
+                  rules::type::signal() + rules::path(path) +
+                      rules::interface(interf) + rules::member("Cleared"),
+                  [this](sdbusplus::message::message&) { ++received; })
+        {
+        }
+
+        sdbusplus::bus::bus bus;
+        sdbusplus::bus::match_t match;
+        size_t received = 0;
+    };
+
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    for (auto i = 0; i < state.range(0); ++i)
+    {
+        subscribers.emplace_back(std::make_unique<Subscriber>());
+    }
+
+    // Wait for the connection to be set up, as signals are queued until it
+    // is and the loop only processes the bus now and then.
+    bus.get_unique_name();
+
+    size_t sent = 0;
+    for (auto _ : state)
+    {
+        calculator.clear();
+        ++sent;
+
+        for (auto& s : subscribers)
+        {
+            while (s->received < sent)
+            {
+                s->bus.wait(100000);
+                s->bus.process_discard();
+            }
+        }
+
+        if ((sent % 64) == 0)
+        {
+            bus.process_discard();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SignalFanout)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+BENCHMARK_MAIN();
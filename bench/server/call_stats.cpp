@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include <sdbusplus/server/call_stats.hpp>
+
+// Measures the per-callback cost of the call statistics, as recorded by the
+// generated server bindings when built with --enable-call-stats.
+//
+//     - BM_TimerDisabled: the no-op timer used without --enable-call-stats.
+//     - BM_TimerEnabled: timing and counting one call.
+//     - BM_Snapshot: taking a snapshot of 'N' methods.
+
+namespace call_stats = sdbusplus::server::call_stats;
+
+static void BM_TimerDisabled(benchmark::State& state)
+{
+    static call_stats::site<false> site{"xyz.openbmc_project.Bench", "Method",
+                                        call_stats::kind::method};
+    for (auto _ : state)
+    {
+        call_stats::timer<false> t(site);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimerDisabled);
+
+static void BM_TimerEnabled(benchmark::State& state)
+{
+    static call_stats::site<true> site{"xyz.openbmc_project.Bench", "Method",
+                                       call_stats::kind::method};
+    for (auto _ : state)
+    {
+        call_stats::timer<true> t(site);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimerEnabled);
+
+static void BM_Snapshot(benchmark::State& state)
+{
+    static std::vector<std::unique_ptr<call_stats::site<true>>> sites;
+    while (sites.size() < static_cast<size_t>(state.range(0)))
+    {
+        sites.emplace_back(new call_stats::site<true>{
+                "xyz.openbmc_project.Bench", "Snapshot",
+                call_stats::kind::method});
+        call_stats::timer<true> t(*sites.back());
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(call_stats::snapshot());
+    }
+}
+BENCHMARK(BM_Snapshot)->Arg(16)->Arg(256);
+
+BENCHMARK_MAIN();
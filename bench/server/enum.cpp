@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Bench/server.hpp>
+
+// Measures the conversion of a generated enumeration with 50+ values to and
+// from its fully qualified string form, as done for every Get, Set and
+// PropertiesChanged of an enum property.
+
+using Bench = sdbusplus::xyz::openbmc_project::server::Bench;
+using Reason = Bench::Reason;
+
+static constexpr auto first = Reason::PowerOn;
+static constexpr auto last = Reason::Unknown;
+
+static std::vector<std::string> allStrings()
+{
+    using sdbusplus::xyz::openbmc_project::server::
+            convertForMessage;
+
+    std::vector<std::string> result;
+    for (auto i = static_cast<int>(first); i <= static_cast<int>(last); ++i)
+    {
+        result.emplace_back(convertForMessage(static_cast<Reason>(i)));
+    }
+    return result;
+}
+
+static void BM_EnumFromString(benchmark::State& state)
+{
+    auto strings = allStrings();
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            Bench::convertReasonFromString(strings[i]));
+        i = (i + 1) % strings.size();
+    }
+    state.counters["values"] = strings.size();
+}
+BENCHMARK(BM_EnumFromString);
+
+static void BM_EnumToString(benchmark::State& state)
+{
+    using sdbusplus::xyz::openbmc_project::server::
+            convertForMessage;
+
+    auto i = static_cast<int>(first);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(convertForMessage(static_cast<Reason>(i)));
+        i = (i == static_cast<int>(last)) ? static_cast<int>(first) : i + 1;
+    }
+}
+BENCHMARK(BM_EnumToString);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Bench/Lookup/error.hpp>
+#include <xyz/openbmc_project/Bench/Lookup/server.hpp>
+#include <xyz/openbmc_project/Bench/LookupResult/server.hpp>
+
+// Measures a method call which fails with a generated error, when the
+// handler throws the error and when it returns it in a method_result_t
+// (sdbus++ --method-errors=result), and the successful call for reference.
+// The calls are made over a peer-to-peer connection to a server on its own
+// thread.
+
+namespace server = sdbusplus::xyz::openbmc_project::Bench::server;
+using NotFound =
+        sdbusplus::xyz::openbmc_project::Bench::Lookup::Error::NotFound;
+
+static constexpr auto path = "/xyz/openbmc_project/sdbusplus/bench/lookup";
+
+static const std::map<std::string, std::string> values = {
+    { "present", "value" } };
+
+/** Lookup, throwing errors. */
+struct Lookup : sdbusplus::server::object_t<server::Lookup>
+{
+    using sdbusplus::server::object_t<server::Lookup>::object;
+
+    static constexpr auto interf = "xyz.openbmc_project.Bench.Lookup";
+
+    std::string find(std::string key) override
+    {
+        auto v = values.find(key);
+        if (v == values.end())
+        {
+            throw NotFound();
+        }
+        return v->second;
+    }
+};
+
+/** Lookup, returning errors. */
+struct LookupResult : sdbusplus::server::object_t<server::LookupResult>
+{
+    using sdbusplus::server::object_t<server::LookupResult>::object;
+
+    static constexpr auto interf = "xyz.openbmc_project.Bench.LookupResult";
+
+    sdbusplus::server::method_result_t<std::string> find(
+            std::string key) override
+    {
+        auto v = values.find(key);
+        if (v == values.end())
+        {
+            return NotFound();
+        }
+        return v->second;
+    }
+};
+
+/** An object served on its own thread, over a socketpair to a client. */
+template <typename Object>
+class Server
+{
+    public:
+        Server()
+        {
+            int fds[2];
+            socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+
+            sd_id128_t id;
+            sd_id128_randomize(&id);
+
+            sd_bus* b = nullptr;
+            sd_bus_new(&b);
+            sd_bus_set_fd(b, fds[0], fds[0]);
+            sd_bus_set_server(b, 1, id);
+            sd_bus_start(b);
+            bus = std::make_unique<sdbusplus::bus::bus>(b, std::false_type());
+
+            sd_bus_new(&b);
+            sd_bus_set_fd(b, fds[1], fds[1]);
+            sd_bus_start(b);
+            client = std::make_unique<sdbusplus::bus::bus>(
+                    b, std::false_type());
+
+            object = std::make_unique<Object>(*bus, path);
+
+            thread = std::thread([this]
+                {
+                    while (!stop)
+                    {
+                        bus->wait(10000);
+                        bus->process_discard();
+                    }
+                });
+        }
+
+        ~Server()
+        {
+            stop = true;
+            thread.join();
+            object.reset();
+            client.reset();
+        }
+
+        std::unique_ptr<sdbusplus::bus::bus> bus;
+        std::unique_ptr<sdbusplus::bus::bus> client;
+
+    private:
+        std::unique_ptr<Object> object;
+        std::atomic<bool> stop{false};
+        std::thread thread;
+};
+
+/** Call Find with a key which is present, or one which is not. */
+template <typename Object, bool Found>
+static void BM_Find(benchmark::State& state)
+{
+    Server<Object> server;
+
+    for (auto _ : state)
+    {
+        auto m = server.client->new_method_call(nullptr, path, Object::interf,
+                                                "Find");
+        m.append(Found ? "present" : "absent");
+        auto reply = server.client->try_call(m);
+        benchmark::DoNotOptimize(reply);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Find, Lookup, true)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Find, LookupResult, true)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Find, Lookup, false)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Find, LookupResult, false)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,283 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <malloc.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/server/intern.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
+
+// Measures publishing many objects under an object manager, as an inventory
+// or logging service does at startup, either with each object signalling
+// from its constructor or with the signals grouped through a batch.
+//
+// Reported per run:
+//     - Time: producer time to construct, register and signal all objects.
+//     - drain_ms: time until a separate consumer has seen every signal.
+//     - signals: InterfacesAdded signals routed by the broker.
+//     - wakeups: times the consumer woke up with data to read.
+//
+// Also measures the heap footprint of an object composed of several
+// interfaces, as reported by mallinfo2, and the cost of acquiring an
+// interned path or name which is already held.
+
+static constexpr auto root = "/xyz/openbmc_project/sdbusplus/bench/object";
+
+/** A small sensor-like interface with a handful of int32 properties. */
+struct Sensor
+{
+    Sensor(sdbusplus::bus::bus& bus, const char* path) :
+        _interface(bus, path, "xyz.openbmc_project.sdbusplus.bench.Sensor",
+                   _vtable, this) {}
+
+    static int get(sd_bus*, const char*, const char*, const char*,
+                   sd_bus_message* reply, void* context, sd_bus_error*)
+    {
+        auto s = static_cast<Sensor*>(context);
+        return sd_bus_message_append_basic(reply, 'i', &s->value);
+    }
+
+    static constexpr sdbusplus::vtable::vtable_t _vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::property("Value", "i", get,
+            sdbusplus::vtable::property_::emits_change),
+        sdbusplus::vtable::property("MinValue", "i", get,
+            sdbusplus::vtable::property_::emits_change),
+        sdbusplus::vtable::property("MaxValue", "i", get,
+            sdbusplus::vtable::property_::emits_change),
+        sdbusplus::vtable::property("Scale", "i", get,
+            sdbusplus::vtable::property_::emits_change),
+        sdbusplus::vtable::end()
+    };
+
+    int32_t value = 42;
+    sdbusplus::server::interface_t _interface;
+};
+constexpr sdbusplus::vtable::vtable_t Sensor::_vtable[];
+
+using Object = sdbusplus::server::object_t<Sensor>;
+
+/** Counts InterfacesAdded signals on its own connection and thread. */
+class Consumer
+{
+    public:
+        explicit Consumer(size_t expected) : expected(expected)
+        {
+            sd_bus_open(&bus);
+            sdbusplus::bus::bus b{bus};
+            match = std::make_unique<sdbusplus::bus::match_t>(b,
+                        sdbusplus::bus::match::rules::interfacesAdded(),
+                        [this](sdbusplus::message::message&)
+                        {
+                            ++received;
+                        });
+            thread = std::thread([this]{ run(); });
+        }
+
+        ~Consumer()
+        {
+            join();
+            match.reset();
+            sd_bus_flush_close_unref(bus);
+        }
+
+        /** Wait for the consumer to see every signal. */
+        void join()
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        std::atomic<size_t> received{0};
+        size_t wakeups = 0;
+
+    private:
+        void run()
+        {
+            using namespace std::chrono;
+            auto last = steady_clock::now();
+
+            while (received < expected &&
+                   steady_clock::now() - last < seconds(5))
+            {
+                if (sd_bus_wait(bus, 100000) > 0)
+                {
+                    ++wakeups;
+                    last = steady_clock::now();
+                }
+                while (sd_bus_process(bus, nullptr) > 0);
+            }
+        }
+
+        size_t expected;
+        sd_bus* bus = nullptr;
+        std::unique_ptr<sdbusplus::bus::match_t> match;
+        std::thread thread;
+};
+
+static std::string path(size_t i)
+{
+    return std::string(root) + "/" + std::to_string(i);
+}
+
+template <bool Batched>
+static void BM_PublishObjects(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto count = static_cast<size_t>(state.range(0));
+    sd_bus* b = nullptr;
+    sd_bus_open(&b);
+    sdbusplus::bus::bus bus{b, std::false_type()};
+    sdbusplus::server::manager_t manager{bus, root};
+
+    for (auto _ : state)
+    {
+        Consumer consumer{count};
+        std::vector<std::unique_ptr<Object>> objects;
+        objects.reserve(count);
+
+        auto start = steady_clock::now();
+        {
+            std::unique_ptr<sdbusplus::server::batch_t> batch;
+            if (Batched)
+            {
+                batch = std::make_unique<sdbusplus::server::batch_t>(bus);
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                objects.emplace_back(
+                    std::make_unique<Object>(bus, path(i).c_str()));
+            }
+        }
+        sd_bus_flush(b);
+        auto published = steady_clock::now();
+
+        consumer.join();
+        auto drained = steady_clock::now();
+
+        state.SetIterationTime(
+            duration_cast<duration<double>>(published - start).count());
+        state.counters["drain_ms"] =
+            duration_cast<milliseconds>(drained - start).count();
+        state.counters["signals"] = consumer.received.load();
+        state.counters["wakeups"] = consumer.wakeups;
+
+        // Tear down outside of the measurement.
+        objects.clear();
+        bus.process_discard();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_PublishObjects, false)
+    ->Arg(1000)->Arg(10000)->Arg(100000)
+    ->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PublishObjects, true)
+    ->Arg(1000)->Arg(10000)->Arg(100000)
+    ->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+/** One of several distinct, property-less interfaces to compose. */
+template <size_t N>
+struct Part
+{
+    Part(sdbusplus::bus::bus& bus, const char* path) :
+        _interface(bus, path, name(), _vtable, this) {}
+
+    static const char* name()
+    {
+        static const auto n =
+            "xyz.openbmc_project.sdbusplus.bench.Part" + std::to_string(N);
+        return n.c_str();
+    }
+
+    static constexpr sdbusplus::vtable::vtable_t _vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::end()
+    };
+
+    sdbusplus::server::interface_t _interface;
+};
+template <size_t N>
+constexpr sdbusplus::vtable::vtable_t Part<N>::_vtable[];
+
+using Composed = sdbusplus::server::object_t<Part<0>, Part<1>, Part<2>,
+                                             Part<3>, Part<4>>;
+
+static void BM_ObjectFootprint(benchmark::State& state)
+{
+    auto count = static_cast<size_t>(state.range(0));
+    sd_bus* b = nullptr;
+    sd_bus_open(&b);
+    sdbusplus::bus::bus bus{b, std::false_type()};
+
+    for (auto _ : state)
+    {
+        std::vector<std::unique_ptr<Composed>> objects;
+        objects.reserve(count);
+
+        auto before = mallinfo2().uordblks;
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects.emplace_back(
+                std::make_unique<Composed>(bus, path(i).c_str(), true));
+        }
+        auto after = mallinfo2().uordblks;
+
+        state.counters["bytes_per_object"] =
+            static_cast<double>(after - before) / count;
+        state.counters["sizeof_object"] = sizeof(Composed);
+
+        objects.clear();
+        bus.process_discard();
+    }
+}
+
+BENCHMARK(BM_ObjectFootprint)->Arg(10000)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+/** Acquire a path held by one of 10k objects, as each interface of a
+ *  composed object does. */
+static void BM_InternPath(benchmark::State& state)
+{
+    sd_bus* b = nullptr;
+    sd_bus_open(&b);
+    sdbusplus::bus::bus bus{b, std::false_type()};
+
+    std::vector<sdbusplus::server::intern::path> held;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        held.emplace_back(b, path(i).c_str());
+    }
+
+    auto p = path(5000);
+    for (auto _ : state)
+    {
+        sdbusplus::server::intern::path interned{b, p.c_str()};
+        benchmark::DoNotOptimize(interned.c_str());
+    }
+}
+BENCHMARK(BM_InternPath);
+
+/** Acquire an interface name which is already held. */
+static void BM_InternName(benchmark::State& state)
+{
+    sdbusplus::server::intern::name held{Part<0>::name()};
+
+    for (auto _ : state)
+    {
+        sdbusplus::server::intern::name interned{Part<0>::name()};
+        benchmark::DoNotOptimize(interned.c_str());
+    }
+}
+BENCHMARK(BM_InternName);
+
+BENCHMARK_MAIN();
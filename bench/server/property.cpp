@@ -0,0 +1,216 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Bench/server.hpp>
+
+// Measures Get and GetAll round trips on large properties against a server
+// on its own connection and thread, the cost of setting a jittering sensor
+// reading with and without a change policy, of setting a large array
+// which signals its value or only an invalidation, and of updating several
+// properties with a signal each or with one grouped signal.
+
+using Bench = sdbusplus::server::object_t<
+        sdbusplus::xyz::openbmc_project::server::Bench>;
+
+static constexpr auto path = "/xyz/openbmc_project/sdbusplus/bench/property";
+static constexpr auto interf = "xyz.openbmc_project.Bench";
+
+/** Serves a Bench object with large property values. */
+class Server
+{
+    public:
+        Server() :
+            bus(sdbusplus::bus::new_default()),
+            service(bus.get_unique_name()),
+            object(bus, path)
+        {
+            std::vector<std::string> names;
+            std::vector<double> readings;
+            std::map<std::string, std::string> assets;
+            for (auto i = 0; i < 200; ++i)
+            {
+                auto n = std::to_string(i);
+                names.push_back("xyz.openbmc_project.Inventory.Item." + n);
+                assets.emplace("asset" + n, "/chassis/motherboard/slot" + n);
+            }
+            for (auto i = 0; i < 1000; ++i)
+            {
+                readings.push_back(i * 0.5);
+            }
+            object.names(std::move(names));
+            object.readings(std::move(readings));
+            object.assets(std::move(assets));
+
+            thread = std::thread([this]
+                {
+                    while (!stop)
+                    {
+                        bus.wait(10000);
+                        bus.process_discard();
+                    }
+                });
+        }
+
+        ~Server()
+        {
+            stop = true;
+            thread.join();
+        }
+
+        sdbusplus::bus::bus bus;
+        std::string service;
+
+    private:
+        Bench object;
+        std::atomic<bool> stop{false};
+        std::thread thread;
+};
+
+static void get(benchmark::State& state, const char* property)
+{
+    Server server;
+    auto client = sdbusplus::bus::new_default();
+
+    for (auto _ : state)
+    {
+        auto m = client.new_method_call(server.service.c_str(), path,
+                                        "org.freedesktop.DBus.Properties",
+                                        "Get");
+        m.append(interf, property);
+        auto reply = client.call(m);
+        benchmark::DoNotOptimize(reply);
+    }
+}
+
+static void BM_GetStrings(benchmark::State& state)
+{
+    get(state, "Names");
+}
+BENCHMARK(BM_GetStrings);
+
+static void BM_GetDoubles(benchmark::State& state)
+{
+    get(state, "Readings");
+}
+BENCHMARK(BM_GetDoubles);
+
+static void BM_GetAll(benchmark::State& state)
+{
+    Server server;
+    auto client = sdbusplus::bus::new_default();
+
+    for (auto _ : state)
+    {
+        auto m = client.new_method_call(server.service.c_str(), path,
+                                        "org.freedesktop.DBus.Properties",
+                                        "GetAll");
+        m.append(interf);
+        auto reply = client.call(m);
+        benchmark::DoNotOptimize(reply);
+    }
+}
+BENCHMARK(BM_GetAll);
+
+/** Set a reading which jitters by less than its deadband around 20.0. */
+template <bool Filtered>
+static void BM_SetJitter(benchmark::State& state)
+{
+    auto bus = sdbusplus::bus::new_default();
+    Bench object(bus, path);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        auto value = 20.0 + ((++i % 8) * 0.01);
+        if (Filtered)
+        {
+            object.filteredTemperature(value);
+        }
+        else
+        {
+            object.temperature(value);
+        }
+
+        if ((i % 64) == 0)
+        {
+            bus.process_discard();
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_SetJitter, false);
+BENCHMARK_TEMPLATE(BM_SetJitter, true);
+
+/** Set a 200-string array to alternating values. */
+template <bool Invalidation>
+static void BM_SetStrings(benchmark::State& state)
+{
+    auto bus = sdbusplus::bus::new_default();
+    Bench object(bus, path);
+
+    std::vector<std::string> names[2];
+    for (auto i = 0; i < 200; ++i)
+    {
+        auto n = std::to_string(i);
+        names[0].push_back("xyz.openbmc_project.Inventory.Item." + n);
+        names[1].push_back("xyz.openbmc_project.Inventory.Other." + n);
+    }
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        auto& value = names[++i % 2];
+        if (Invalidation)
+        {
+            object.invalidatedNames(value);
+        }
+        else
+        {
+            object.names(value);
+        }
+
+        if ((i % 64) == 0)
+        {
+            bus.process_discard();
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_SetStrings, false);
+BENCHMARK_TEMPLATE(BM_SetStrings, true);
+
+/** Update three properties together. */
+template <bool Grouped>
+static void BM_BulkUpdate(benchmark::State& state)
+{
+    using Reason = sdbusplus::xyz::openbmc_project::server::Bench::Reason;
+
+    auto bus = sdbusplus::bus::new_default();
+    Bench object(bus, path);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        ++i;
+        auto reason = (i % 2) ? Reason::PowerOn : Reason::PowerOff;
+        object.temperature(20.0 + (i % 8), Grouped);
+        object.filteredTemperature(30.0 + (i % 8), Grouped);
+        object.reason(reason, Grouped);
+        if (Grouped)
+        {
+            object.emitChanged();
+        }
+
+        if ((i % 64) == 0)
+        {
+            bus.process_discard();
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_BulkUpdate, false);
+BENCHMARK_TEMPLATE(BM_BulkUpdate, true);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <xyz/openbmc_project/Bench/server.hpp>
+
+// Measures the time the program spends in dynamic initializers, from the
+// first (highest priority) static constructor until main().  This includes
+// the initializers of the linked generated bindings; their signature tables
+// and vtables are constant-initialized and so should not contribute.
+
+using namespace std::chrono;
+
+static steady_clock::time_point initStart;
+
+__attribute__((constructor(101))) static void markInitStart()
+{
+    initStart = steady_clock::now();
+}
+
+static steady_clock::duration initTime;
+
+static void BM_StaticInit(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.SetIterationTime(duration_cast<duration<double>>(
+                initTime).count());
+    }
+}
+BENCHMARK(BM_StaticInit)->Iterations(1)->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv)
+{
+    initTime = steady_clock::now() - initStart;
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+}
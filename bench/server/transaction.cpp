@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/transaction.hpp>
+
+// Measures the per-callback cost of setting the transaction id, as done by
+// the generated server bindings when built with --enable-transaction.
+//
+//     - BM_SetIdDisabled: no transaction id, for reference.
+//     - BM_SetIdLegacy: the previous scheme, hashing a Transaction of the
+//       message's bus and cookie, which looks up the unique name as a
+//       std::string.
+//     - BM_SetId: set_id_from_message() on a message of our own, which has
+//       no sender, so the hash of the connection's unique name is used.
+//     - BM_SetIdReceived: set_id_from_message() on a call received through
+//       the broker, as in the server callbacks, which uses the hash of the
+//       sender's unique name.
+
+namespace transaction = sdbusplus::server::transaction;
+
+/** A message on its own connection, sealed so it has a cookie. */
+struct Message
+{
+    Message()
+    {
+        sd_bus_open(&bus);
+        sd_bus_message_new_method_call(bus, &msg, "org.freedesktop.DBus",
+                                       "/org/freedesktop/DBus",
+                                       "org.freedesktop.DBus", "GetId");
+        sd_bus_message_seal(msg, 1, 0);
+    }
+
+    ~Message()
+    {
+        sd_bus_message_unref(msg);
+        sd_bus_flush_close_unref(bus);
+    }
+
+    sd_bus* bus = nullptr;
+    sd_bus_message* msg = nullptr;
+};
+
+/** A method call received from another connection, so it has a sender. */
+struct Received
+{
+    Received()
+    {
+        sd_bus_open(&bus);
+        sd_bus_open(&client);
+        sd_bus_add_filter(bus, nullptr, filter, this);
+
+        const char* name = nullptr;
+        sd_bus_get_unique_name(bus, &name);
+
+        sd_bus_message* call = nullptr;
+        sd_bus_message_new_method_call(client, &call, name,
+                                       "/xyz/openbmc_project/sdbusplus/bench",
+                                       "xyz.openbmc_project.sdbusplus.Bench",
+                                       "Call");
+        sd_bus_send(client, call, nullptr);
+        sd_bus_message_unref(call);
+
+        for (size_t i = 0; !msg && i < 100; ++i)
+        {
+            while (sd_bus_process(client, nullptr) > 0);
+            sd_bus_wait(bus, 10000);
+            while (sd_bus_process(bus, nullptr) > 0);
+        }
+    }
+
+    ~Received()
+    {
+        sd_bus_message_unref(msg);
+        sd_bus_flush_close_unref(client);
+        sd_bus_flush_close_unref(bus);
+    }
+
+    static int filter(sd_bus_message* m, void* context, sd_bus_error*)
+    {
+        auto r = static_cast<Received*>(context);
+        if (!r->msg && sd_bus_message_get_sender(m) &&
+            sd_bus_message_is_method_call(m, nullptr, "Call"))
+        {
+            r->msg = sd_bus_message_ref(m);
+        }
+        return 0;
+    }
+
+    sd_bus* bus = nullptr;
+    sd_bus* client = nullptr;
+    sd_bus_message* msg = nullptr;
+};
+
+static void BM_SetIdDisabled(benchmark::State& state)
+{
+    Message m;
+    for (auto _ : state)
+    {
+        auto msg = sdbusplus::message::message(m.msg);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_SetIdDisabled);
+
+static void BM_SetIdLegacy(benchmark::State& state)
+{
+    Message m;
+    for (auto _ : state)
+    {
+        auto msg = sdbusplus::message::message(m.msg);
+        auto tbus = msg.get_bus();
+        transaction::Transaction t(tbus, msg);
+        transaction::set_id(std::hash<transaction::Transaction>{}(t));
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_SetIdLegacy);
+
+static void BM_SetId(benchmark::State& state)
+{
+    Message m;
+    for (auto _ : state)
+    {
+        transaction::set_id_from_message(m.msg);
+        auto msg = sdbusplus::message::message(m.msg);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_SetId);
+
+static void BM_SetIdReceived(benchmark::State& state)
+{
+    Received m;
+    if (!m.msg)
+    {
+        state.SkipWithError("The call was not received.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        transaction::set_id_from_message(m.msg);
+        auto msg = sdbusplus::message::message(m.msg);
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK(BM_SetIdReceived);
+
+BENCHMARK_MAIN();
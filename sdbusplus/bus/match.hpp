@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
 #include <sdbusplus/slot.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/message.hpp>
+#include <sdbusplus/probe.hpp>
 
 namespace sdbusplus
 {
@@ -16,6 +18,80 @@ namespace bus
 namespace match
 {
 
+namespace details
+{
+
+/** @brief Process-wide counts of the matches, for server::stats. */
+struct counters
+{
+    /** The matches currently registered. */
+    std::atomic<uint64_t> registered;
+    /** The callbacks run by matches with a callback_t. */
+    std::atomic<uint64_t> callbacks;
+};
+
+inline counters& get_counters()
+{
+    static counters c{};
+    return c;
+}
+
+/** @brief Counts a registered match, moving with the match's slot. */
+struct registration
+{
+    registration() = default;
+    registration(const registration&) = delete;
+    registration& operator=(const registration&) = delete;
+
+    registration(registration&& other) : _counted(other._counted)
+    {
+        other._counted = false;
+    }
+
+    registration& operator=(registration&& other)
+    {
+        if (this != &other)
+        {
+            release();
+            _counted = other._counted;
+            other._counted = false;
+        }
+        return *this;
+    }
+
+    ~registration()
+    {
+        release();
+    }
+
+    /** @brief Count the match if it was registered. */
+    void count(bool registered)
+    {
+        release();
+        if (registered)
+        {
+            get_counters().registered.fetch_add(1,
+                                                std::memory_order_relaxed);
+            _counted = true;
+        }
+    }
+
+    private:
+        bool _counted = false;
+
+        void release()
+        {
+            if (_counted)
+            {
+                get_counters().registered.fetch_sub(
+                        1, std::memory_order_relaxed);
+                _counted = false;
+            }
+        }
+};
+
+} // namespace details
+
 struct match
 {
     /* Define all of the basic class operations:
@@ -48,6 +124,7 @@ struct match
         sd_bus_add_match(bus.get(), &slot, match, handler, context);
 
         _slot = decltype(_slot){slot};
+        _registration.count(slot != nullptr);
     }
     match(sdbusplus::bus::bus& bus, const std::string& _match,
           sd_bus_message_handler_t handler, void* context = nullptr)
@@ -71,6 +148,7 @@ struct match
                          _callback.get());
 
         _slot = decltype(_slot){slot};
+        _registration.count(slot != nullptr);
     }
     match(sdbusplus::bus::bus& bus, const std::string& _match,
           callback_t callback)
@@ -79,14 +157,26 @@ struct match
     private:
         slot::slot _slot;
         std::unique_ptr<callback_t> _callback = nullptr;
+        details::registration _registration;
 
         static int callCallback(sd_bus_message *m, void* context,
                                 sd_bus_error* e)
         {
+            details::get_counters().callbacks.fetch_add(
+                    1, std::memory_order_relaxed);
+
             auto c = static_cast<callback_t*>(context);
             message::message message{m};
 
+            SDBUSPLUS_PROBE(match__entry, sd_bus_message_get_sender(m),
+                            sd_bus_message_get_path(m),
+                            sd_bus_message_get_interface(m),
+                            sd_bus_message_get_member(m));
             (*c)(message);
+            SDBUSPLUS_PROBE(match__return, sd_bus_message_get_sender(m),
+                            sd_bus_message_get_path(m),
+                            sd_bus_message_get_interface(m),
+                            sd_bus_message_get_member(m));
 
             return 0;
         }
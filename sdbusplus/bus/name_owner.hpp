@@ -0,0 +1,151 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+namespace sdbusplus
+{
+
+namespace bus
+{
+
+namespace name_owner
+{
+
+/** @class cache
+ *  @brief Local cache of bus-name to unique-name ownership.
+ *
+ *  Registers a match for 'NameOwnerChanged' and keeps a map of the names
+ *  it has seen to their current owner, so that 'is X on the bus' and 'who
+ *  owns X' can usually be answered without a round trip to the broker.
+ *  A name not yet in the cache is resolved once with 'GetNameOwner' and
+ *  kept up to date from the signals afterwards.
+ *
+ *  The cache is only as fresh as the last time the bus was processed, since
+ *  updates arrive as signals through the normal process() path.
+ */
+struct cache
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy operations due to internal unique_ptr.
+         *         - Move operations due to 'this' being registered as the
+         *           'context' with the match.
+         *     Allowed:
+         *         - Destructor.
+         */
+    cache() = delete;
+    cache(const cache&) = delete;
+    cache& operator=(const cache&) = delete;
+    cache(cache&&) = delete;
+    cache& operator=(cache&&) = delete;
+    ~cache() = default;
+
+    /** @brief Start tracking name ownership on a bus.
+     *
+     *  @param[in] bus - The bus to track names on.
+     */
+    explicit cache(sdbusplus::bus::bus& bus) :
+        _bus(bus.get()),
+        _match(bus, match::rules::nameOwnerChanged(), nameOwnerChanged, this)
+    {
+    }
+
+    /** @brief Get the unique name currently owning a bus name.
+     *
+     *  @param[in] name - The well-known (or unique) name to look up.
+     *
+     *  @return The owning unique name, ex. ":1.11", or an empty string if
+     *          the name has no owner.
+     */
+    const std::string& owner(const std::string& name)
+    {
+        auto i = _owners.find(name);
+        if (i == _owners.end())
+        {
+            i = _owners.emplace(name, getNameOwner(name)).first;
+        }
+
+        return i->second;
+    }
+
+    /** @brief Check if a bus name currently has an owner.
+     *
+     *  @param[in] name - The well-known (or unique) name to look up.
+     *
+     *  @return True - if the name is owned by a connection.
+     */
+    bool has_owner(const std::string& name)
+    {
+        return !owner(name).empty();
+    }
+
+    /** @brief Drop all cached ownership, forcing new lookups. */
+    void clear()
+    {
+        _owners.clear();
+    }
+
+    private:
+        sdbusplus::bus::bus _bus;
+        match::match _match;
+
+        /** Map of bus name to owner; an empty owner means 'not on the bus'.
+         */
+        std::map<std::string, std::string> _owners;
+
+        /** @brief Resolve a name through org.freedesktop.DBus.GetNameOwner.
+         */
+        std::string getNameOwner(const std::string& name)
+        {
+            auto m = _bus.new_method_call("org.freedesktop.DBus",
+                                          "/org/freedesktop/DBus",
+                                          "org.freedesktop.DBus",
+                                          "GetNameOwner");
+            m.append(name);
+
+            std::string unique{};
+            auto reply = _bus.call(m);
+            if (reply && !reply.is_method_error())
+            {
+                reply.read(unique);
+            }
+
+            return unique;
+        }
+
+        /** @brief sd-bus callback for NameOwnerChanged signals. */
+        static int nameOwnerChanged(sd_bus_message* msg, void* context,
+                                    sd_bus_error* error)
+        {
+            auto c = static_cast<cache*>(context);
+            auto m = message::message(msg);
+
+            std::string name{}, oldOwner{}, newOwner{};
+            m.read(name, oldOwner, newOwner);
+
+            // Unique names are never reused, so forget them once they are
+            // released rather than caching them as 'no owner' forever.
+            if (newOwner.empty() && !name.empty() && name[0] == ':')
+            {
+                c->_owners.erase(name);
+            }
+            else
+            {
+                c->_owners[name] = std::move(newOwner);
+            }
+
+            return 0;
+        }
+};
+
+} // namespace name_owner
+
+using name_owner_cache_t = name_owner::cache;
+
+} // namespace bus
+} // namespace sdbusplus
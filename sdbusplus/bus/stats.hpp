@@ -0,0 +1,346 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/slot.hpp>
+
+namespace sdbusplus
+{
+
+namespace bus
+{
+
+namespace stats
+{
+
+/** @struct stats
+ *  @brief Statistics of a bus connection, from bus::get_stats().
+ *
+ *  The statistics are kept per connection, so every bus object of the
+ *  connection counts into them and reports them, for as long as the bus
+ *  object enable_stats() was called on is alive.
+ *
+ *  Messages received are counted by a filter.  Messages sent are counted
+ *  where sdbusplus sends them: calls, message::method_return() and
+ *  signal_send(), the signals of server::interface and server::object, and
+ *  the error replies of generated callbacks.  Messages sd-bus builds and
+ *  sends itself, such as the replies to Properties.Get and Introspect, or
+ *  the errors for unknown objects, are not counted.  A bus attached to an
+ *  sd-event loop is processed by sd-event, so its processing time and
+ *  wakeups are not counted.
+ */
+struct stats
+{
+    /** Method calls received. */
+    uint64_t received_calls;
+    /** Signals received. */
+    uint64_t received_signals;
+    /** Method returns received. */
+    uint64_t received_replies;
+    /** Errors received, including error replies to call(). */
+    uint64_t received_errors;
+
+    /** Method calls made with call() and call_noreply(). */
+    uint64_t sent_calls;
+    /** Signals sent. */
+    uint64_t sent_signals;
+    /** Method returns sent. */
+    uint64_t sent_replies;
+    /** Errors sent. */
+    uint64_t sent_errors;
+    /** Calls which failed without a reply, such as by timing out. */
+    uint64_t failed_calls;
+    /** Time spent waiting in call() and call_noreply(), in nsec. */
+    uint64_t call_time;
+
+    /** Messages read but not yet processed, at the time of the snapshot. */
+    uint64_t queued_read;
+    /** Messages not yet written, at the time of the snapshot. */
+    uint64_t queued_write;
+
+    /** Calls of process() and process_discard(). */
+    uint64_t process_calls;
+    /** Time spent in process() and process_discard(), in nsec. */
+    uint64_t process_time;
+    /** Returns from wait() after which the first process() found no work. */
+    uint64_t empty_wakeups;
+};
+
+namespace details
+{
+
+struct state;
+
+/** @brief The number of connections with statistics enabled. */
+inline std::atomic<size_t>& enabled()
+{
+    static std::atomic<size_t> n{0};
+    return n;
+}
+
+/** @brief The lock of the registry.
+ *
+ *  Looking up a connection takes it shared, so the threads counting into
+ *  their connections do not wait for each other; enabling and disabling
+ *  statistics take it exclusively.
+ */
+inline std::shared_timed_mutex& registry_mutex()
+{
+    static std::shared_timed_mutex m;
+    return m;
+}
+
+/** @brief The state of each connection with statistics enabled. */
+inline std::map<sd_bus*, state*>& registry()
+{
+    static std::map<sd_bus*, state*> r;
+    return r;
+}
+
+/** @brief The counters of stats, updated without a lock. */
+struct counters
+{
+    std::atomic<uint64_t> received_calls{0};
+    std::atomic<uint64_t> received_signals{0};
+    std::atomic<uint64_t> received_replies{0};
+    std::atomic<uint64_t> received_errors{0};
+    std::atomic<uint64_t> sent_calls{0};
+    std::atomic<uint64_t> sent_signals{0};
+    std::atomic<uint64_t> sent_replies{0};
+    std::atomic<uint64_t> sent_errors{0};
+    std::atomic<uint64_t> failed_calls{0};
+    std::atomic<uint64_t> call_time{0};
+    std::atomic<uint64_t> process_calls{0};
+    std::atomic<uint64_t> process_time{0};
+    std::atomic<uint64_t> empty_wakeups{0};
+
+    /** @brief Add to a counter. */
+    static void add(std::atomic<uint64_t>& c, uint64_t n = 1)
+    {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** @brief Read the counters, each at a slightly different time. */
+    stats snapshot() const
+    {
+        auto get = [](const std::atomic<uint64_t>& c)
+            {
+                return c.load(std::memory_order_relaxed);
+            };
+
+        stats s{};
+        s.received_calls = get(received_calls);
+        s.received_signals = get(received_signals);
+        s.received_replies = get(received_replies);
+        s.received_errors = get(received_errors);
+        s.sent_calls = get(sent_calls);
+        s.sent_signals = get(sent_signals);
+        s.sent_replies = get(sent_replies);
+        s.sent_errors = get(sent_errors);
+        s.failed_calls = get(failed_calls);
+        s.call_time = get(call_time);
+        s.process_calls = get(process_calls);
+        s.process_time = get(process_time);
+        s.empty_wakeups = get(empty_wakeups);
+        return s;
+    }
+};
+
+/** @brief The counters of a connection, and the filter which counts the
+ *         messages it receives.
+ *
+ *  Registered for the connection while it exists.
+ */
+struct state
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy and move operations due to 'this' being
+         *           registered for the connection.
+         *     Allowed:
+         *         - Destructor.
+         */
+    state() = delete;
+    state(const state&) = delete;
+    state& operator=(const state&) = delete;
+    state(state&&) = delete;
+    state& operator=(state&&) = delete;
+
+    explicit state(sd_bus* b) : bus(b)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(registry_mutex());
+        registry().emplace(bus, this);
+        ++enabled();
+    }
+
+    ~state()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(registry_mutex());
+        registry().erase(bus);
+        --enabled();
+    }
+
+    sd_bus* bus;
+    details::counters counters;
+
+    /** Set by wait(), until the next process(). */
+    std::atomic<bool> waited{false};
+
+    slot::slot filter{nullptr};
+
+    /** @brief Count a message received by the connection.
+     *
+     *  The state is the context of the filter, so no lookup is needed.
+     */
+    static int filter_callback(sd_bus_message* m, void* context,
+                               sd_bus_error* error)
+    {
+        count_received(m, static_cast<state*>(context)->counters);
+        return 0;
+    }
+
+    static void count_received(sd_bus_message* m, details::counters& c)
+    {
+        uint8_t type = 0;
+        sd_bus_message_get_type(m, &type);
+
+        switch (type)
+        {
+            case SD_BUS_MESSAGE_METHOD_CALL:
+                details::counters::add(c.received_calls);
+                break;
+            case SD_BUS_MESSAGE_SIGNAL:
+                details::counters::add(c.received_signals);
+                break;
+            case SD_BUS_MESSAGE_METHOD_RETURN:
+                details::counters::add(c.received_replies);
+                break;
+            case SD_BUS_MESSAGE_METHOD_ERROR:
+                details::counters::add(c.received_errors);
+                break;
+        }
+    }
+
+    static void count_sent(uint8_t type, details::counters& c)
+    {
+        switch (type)
+        {
+            case SD_BUS_MESSAGE_METHOD_CALL:
+                details::counters::add(c.sent_calls);
+                break;
+            case SD_BUS_MESSAGE_SIGNAL:
+                details::counters::add(c.sent_signals);
+                break;
+            case SD_BUS_MESSAGE_METHOD_RETURN:
+                details::counters::add(c.sent_replies);
+                break;
+            case SD_BUS_MESSAGE_METHOD_ERROR:
+                details::counters::add(c.sent_errors);
+                break;
+        }
+    }
+
+    /** @brief Check if a failed sd_bus_call received an error reply.
+     *
+     *  sd_bus_call fills the error from the errno when it fails locally,
+     *  such as by timing out, and copies it from the reply otherwise.
+     *
+     *  @param[in] r - The result of sd_bus_call.
+     *  @param[in] error - The error filled by sd_bus_call.
+     */
+    static bool is_error_reply(int r, const sd_bus_error* error)
+    {
+        sd_bus_error local = SD_BUS_ERROR_NULL;
+        sd_bus_error_set_errno(&local, r);
+
+        auto same = sd_bus_error_has_name(error, local.name) &&
+                    (error->message == local.message ||
+                     (error->message != nullptr && local.message != nullptr &&
+                      strcmp(error->message, local.message) == 0));
+        sd_bus_error_free(&local);
+
+        return !same;
+    }
+
+    /** @brief Get the CLOCK_MONOTONIC time in nsec. */
+    static uint64_t now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+};
+
+/** @brief Check if statistics are enabled on any connection. */
+inline bool any_enabled()
+{
+    return enabled().load(std::memory_order_relaxed) != 0;
+}
+
+/** @brief Update the counters of a connection, if it has them.
+ *
+ *  @param[in] b - The connection.
+ *  @param[in] update - Functor called with the state of the connection,
+ *                      while holding the lock shared, so the state is not
+ *                      destroyed meanwhile.  It updates the counters with
+ *                      atomic operations.
+ *  @return True if statistics are enabled on the connection.
+ */
+template <typename Update>
+bool update(sd_bus* b, Update&& update)
+{
+    if (!any_enabled())
+    {
+        return false;
+    }
+
+    std::shared_lock<std::shared_timed_mutex> lock(registry_mutex());
+    auto i = registry().find(b);
+    if (i == registry().end())
+    {
+        return false;
+    }
+
+    update(*i->second);
+    return true;
+}
+
+/** @brief Count a message sent on a connection.
+ *
+ *  @param[in] b - The connection.
+ *  @param[in] type - The SD_BUS_MESSAGE_* type of the message.
+ */
+inline void count_sent(sd_bus* b, uint8_t type)
+{
+    update(b, [type](state& s) { state::count_sent(type, s.counters); });
+}
+
+/** @brief Count a message sent with sd_bus_send. */
+inline void count_sent(sd_bus_message* m)
+{
+    if (!any_enabled())
+    {
+        return;
+    }
+
+    uint8_t type = 0;
+    sd_bus_message_get_type(m, &type);
+    count_sent(sd_bus_message_get_bus(m), type);
+}
+
+} // namespace details
+
+} // namespace stats
+
+using stats_t = stats::stats;
+
+} // namespace bus
+
+} // namespace sdbusplus
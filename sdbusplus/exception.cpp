@@ -20,5 +20,32 @@ const char* InvalidEnumString::what() const noexcept
     return errWhat;
 }
 
+SdBusError::SdBusError(int errnum, const char* name, const char* message) :
+    errnum(errnum), errName(name),
+    errDesc(message ? message : ""),
+    errWhat(errName + ": " + errDesc)
+{
+}
+
+const char* SdBusError::name() const noexcept
+{
+    return errName.c_str();
+}
+
+const char* SdBusError::description() const noexcept
+{
+    return errDesc.c_str();
+}
+
+const char* SdBusError::what() const noexcept
+{
+    return errWhat.c_str();
+}
+
+int SdBusError::get_errno() const noexcept
+{
+    return errnum;
+}
+
 } // namespace exception
 } // namespace sdbusplus
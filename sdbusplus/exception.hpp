@@ -1,6 +1,7 @@
 #pragma once
 
 #include <exception>
+#include <string>
 
 namespace sdbusplus
 {
@@ -40,6 +41,31 @@ struct InvalidEnumString final : public internal_exception
     const char* what() const noexcept override;
 };
 
+/** Exception for a failed sd-bus call, from result::value(). */
+struct SdBusError final : public internal_exception
+{
+    /** @brief Construct the exception.
+     *
+     *  @param[in] errnum - The (positive) errno of the failure.
+     *  @param[in] name - The D-Bus error name.
+     *  @param[in] message - The D-Bus error message, or nullptr.
+     */
+    SdBusError(int errnum, const char* name, const char* message);
+
+    const char* name() const noexcept override;
+    const char* description() const noexcept override;
+    const char* what() const noexcept override;
+
+    /** @brief Get the errno of the failure. */
+    int get_errno() const noexcept;
+
+    private:
+        int errnum;
+        std::string errName;
+        std::string errDesc;
+        std::string errWhat;
+};
+
 } // namespace exception
 
 using exception_t = exception::exception;
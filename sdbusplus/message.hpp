@@ -3,9 +3,12 @@
 #include <memory>
 #include <type_traits>
 #include <systemd/sd-bus.h>
+#include <sdbusplus/bus/stats.hpp>
 #include <sdbusplus/message/append.hpp>
 #include <sdbusplus/message/read.hpp>
 #include <sdbusplus/message/native_types.hpp>
+#include <sdbusplus/probe.hpp>
+#include <sdbusplus/result.hpp>
 
 namespace sdbusplus
 {
@@ -96,6 +99,30 @@ struct message
         sdbusplus::message::read(_msg.get(), std::forward<Args>(args)...);
     }
 
+    /** @brief Perform sd_bus_message_append, returning the error if it
+     *         fails, after which the message cannot be sent.
+     *
+     *  @tparam ...Args - Type of items to append to message.
+     *  @param[in] args - Items to append to message.
+     */
+    template <typename ...Args> result_t<void> try_append(Args&&... args)
+    {
+        return result_t<void>(sdbusplus::message::append(
+                _msg.get(), std::forward<Args>(args)...));
+    }
+
+    /** @brief Perform sd_bus_message_read, returning the error if it fails,
+     *         such as when the message does not have the expected types.
+     *
+     *  @tparam ...Args - Type of items to read from message.
+     *  @param[out] args - Items to read from message.
+     */
+    template <typename ...Args> result_t<void> try_read(Args&&... args)
+    {
+        return result_t<void>(sdbusplus::message::read(
+                _msg.get(), std::forward<Args>(args)...));
+    }
+
     /** @brief Get the dbus bus from the message. */
     // Forward declare.
     auto get_bus();
@@ -212,11 +239,20 @@ struct message
     void method_return()
     {
         auto b = sd_bus_message_get_bus(this->get());
-        sd_bus_send(b, this->get(), nullptr);
+        if (sd_bus_send(b, this->get(), nullptr) >= 0)
+        {
+            bus::stats::details::count_sent(this->get());
+        }
     }
 
     /** @brief Perform a 'signal-send' call. */
-    void signal_send() { method_return(); }
+    void signal_send()
+    {
+        SDBUSPLUS_PROBE(signal__send, sd_bus_message_get_path(this->get()),
+                        sd_bus_message_get_interface(this->get()),
+                        sd_bus_message_get_member(this->get()));
+        method_return();
+    }
 
     friend struct sdbusplus::bus::bus;
 
@@ -17,7 +17,7 @@ namespace message
  *  (This is an empty no-op function that is useful in some cases for
  *   variadic template reasons.)
  */
-inline void append(sd_bus_message* m) {};
+inline int append(sd_bus_message* m) { return 0; };
 /** @brief Append data into an sdbus message.
  *
  *  @param[in] msg - The message to append to.
@@ -28,8 +28,12 @@ inline void append(sd_bus_message* m) {};
  *  C++ values and call the sd_bus_message_append functions with the
  *  appropriate type parameters.  It may also do conversions, where needed,
  *  to convert C++ types into C representations (eg. string, vector).
+ *
+ *  @return 0, or a negative errno at the first failure, after which the
+ *          remaining arguments are not appended.  sd-bus does not allow
+ *          a message to be sent once an append to it has failed.
  */
-template <typename ...Args> void append(sd_bus_message* m, Args&&... args);
+template <typename ...Args> int append(sd_bus_message* m, Args&&... args);
 
 namespace details
 {
@@ -113,10 +117,12 @@ template<typename S> struct append_single
      *
      *  @param[in] m - sd_bus_message to append into.
      *  @param[in] t - The item to append.
+     *
+     *  @return A negative errno on failure.
      */
     template<typename T,
              typename = std::enable_if_t<std::is_same<S, Td<T>>::value>>
-    static void op(sd_bus_message* m, T&& t)
+    static int op(sd_bus_message* m, T&& t)
     {
         // For this default implementation, we need to ensure that only
         // basic types are used.
@@ -125,8 +131,8 @@ template<typename S> struct append_single
                       "Non-basic types are not allowed.");
 
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
-        sd_bus_message_append_basic(m, dbusType,
-                                    address_of(std::forward<T>(t)));
+        return sd_bus_message_append_basic(m, dbusType,
+                                           address_of(std::forward<T>(t)));
     }
 };
 
@@ -137,10 +143,10 @@ template<typename T> using append_single_t =
 template <> struct append_single<std::string>
 {
     template<typename T>
-    static void op(sd_bus_message* m, T&& s)
+    static int op(sd_bus_message* m, T&& s)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
-        sd_bus_message_append_basic(m, dbusType, s.c_str());
+        return sd_bus_message_append_basic(m, dbusType, s.c_str());
     }
 };
 
@@ -148,10 +154,10 @@ template <> struct append_single<std::string>
 template <typename T> struct append_single<details::string_wrapper<T>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<S>());
-        sd_bus_message_append_basic(m, dbusType, s.str.c_str());
+        return sd_bus_message_append_basic(m, dbusType, s.str.c_str());
     }
 };
 
@@ -160,25 +166,62 @@ template <typename T> struct append_single<details::string_wrapper<T>>
 template <> struct append_single<bool>
 {
     template<typename T>
-    static void op(sd_bus_message* m, T&& b)
+    static int op(sd_bus_message* m, T&& b)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
         int i = b;
-        sd_bus_message_append_basic(m, dbusType, &i);
+        return sd_bus_message_append_basic(m, dbusType, &i);
     }
 };
 
+/** @struct can_append_array
+ *  @brief Utility to identify types whose arrays can be appended in bulk.
+ *
+ *  The in-memory representation of the fixed-size numeric types matches
+ *  the D-Bus marshalling, so a std::vector of them can be appended with a
+ *  single sd_bus_message_append_array (a memcpy) rather than an
+ *  sd_bus_message_append_basic per element.  'bool' is excluded because a
+ *  D-Bus boolean is 32 bits wide.
+ *
+ *  @tparam T - Type of the array element.
+ */
+template <typename T> struct can_append_array : std::integral_constant<bool,
+        std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
 /** @brief Specialization of append_single for std::vectors. */
 template <typename T> struct append_single<std::vector<T>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
+    {
+        return op(m, std::forward<S>(s), can_append_array<T>());
+    }
+
+    template<typename S>
+    static int op(sd_bus_message* m, S&& s, std::true_type)
+    {
+        constexpr auto dbusType = std::get<0>(types::type_id<T>());
+
+        return sd_bus_message_append_array(m, dbusType, s.data(),
+                                           s.size() * sizeof(T));
+    }
+
+    template<typename S>
+    static int op(sd_bus_message* m, S&& s, std::false_type)
     {
         constexpr auto dbusType = utility::tuple_to_array(types::type_id<T>());
 
-        sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY, dbusType.data());
-        for(auto& i : s) { sdbusplus::message::append(m, i); }
-        sd_bus_message_close_container(m);
+        auto r = sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY,
+                                               dbusType.data());
+        for (auto i = s.begin(); (r >= 0) && (i != s.end()); ++i)
+        {
+            r = sdbusplus::message::append(m, *i);
+        }
+        if (r < 0)
+        {
+            return r;
+        }
+        return sd_bus_message_close_container(m);
     }
 };
 
@@ -186,16 +229,24 @@ template <typename T> struct append_single<std::vector<T>>
 template <typename T1, typename T2> struct append_single<std::pair<T1, T2>>
 {
     template <typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(
                 std::tuple_cat(types::type_id_nonull<T1>(),
                                types::type_id<T2>()));
 
-        sd_bus_message_open_container(
+        auto r = sd_bus_message_open_container(
                 m, SD_BUS_TYPE_DICT_ENTRY, dbusType.data());
-        sdbusplus::message::append(m, s.first, s.second);
-        sd_bus_message_close_container(m);
+        if (r < 0)
+        {
+            return r;
+        }
+        r = sdbusplus::message::append(m, s.first, s.second);
+        if (r < 0)
+        {
+            return r;
+        }
+        return sd_bus_message_close_container(m);
     }
 };
 
@@ -203,14 +254,22 @@ template <typename T1, typename T2> struct append_single<std::pair<T1, T2>>
 template <typename T1, typename T2> struct append_single<std::map<T1, T2>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(
                 types::type_id<typename std::map<T1, T2>::value_type>());
 
-        sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY, dbusType.data());
-        for(auto& i : s) { sdbusplus::message::append(m, i); }
-        sd_bus_message_close_container(m);
+        auto r = sd_bus_message_open_container(m, SD_BUS_TYPE_ARRAY,
+                                               dbusType.data());
+        for (auto i = s.begin(); (r >= 0) && (i != s.end()); ++i)
+        {
+            r = sdbusplus::message::append(m, *i);
+        }
+        if (r < 0)
+        {
+            return r;
+        }
+        return sd_bus_message_close_container(m);
     }
 };
 
@@ -218,25 +277,32 @@ template <typename T1, typename T2> struct append_single<std::map<T1, T2>>
 template <typename ...Args> struct append_single<std::tuple<Args...>>
 {
     template<typename S, std::size_t... I>
-    static void _op(sd_bus_message* m, S&& s,
-                    std::integer_sequence<std::size_t, I...>)
+    static int _op(sd_bus_message* m, S&& s,
+                   std::integer_sequence<std::size_t, I...>)
     {
-        sdbusplus::message::append(m, std::get<I>(s)...);
+        return sdbusplus::message::append(m, std::get<I>(s)...);
     }
 
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(std::tuple_cat(
                 types::type_id_nonull<Args...>(),
                 std::make_tuple('\0') /* null terminator for C-string */));
 
-        sd_bus_message_open_container(
+        auto r = sd_bus_message_open_container(
                 m, SD_BUS_TYPE_STRUCT, dbusType.data());
-        _op(m, std::forward<S>(s),
-            std::make_index_sequence<sizeof...(Args)>());
-        sd_bus_message_close_container(m);
-
+        if (r < 0)
+        {
+            return r;
+        }
+        r = _op(m, std::forward<S>(s),
+                std::make_index_sequence<sizeof...(Args)>());
+        if (r < 0)
+        {
+            return r;
+        }
+        return sd_bus_message_close_container(m);
     }
 };
 
@@ -245,7 +311,7 @@ template <typename ...Args> struct append_single<variant<Args...>>
 {
     template<typename S,
              typename = std::enable_if_t<0 < sizeof...(Args)>>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         auto apply =
             [m](auto&& arg)
@@ -253,14 +319,22 @@ template <typename ...Args> struct append_single<variant<Args...>>
                 constexpr auto dbusType = utility::tuple_to_array(
                     types::type_id<decltype(arg)>());
 
-                sd_bus_message_open_container(m,
-                                              SD_BUS_TYPE_VARIANT,
-                                              dbusType.data());
-                sdbusplus::message::append(m, arg);
-                sd_bus_message_close_container(m);
+                auto r = sd_bus_message_open_container(m,
+                                                       SD_BUS_TYPE_VARIANT,
+                                                       dbusType.data());
+                if (r < 0)
+                {
+                    return r;
+                }
+                r = sdbusplus::message::append(m, arg);
+                if (r < 0)
+                {
+                    return r;
+                }
+                return sd_bus_message_close_container(m);
             };
 
-        std::remove_reference_t<S>::visit(s, apply);
+        return std::remove_reference_t<S>::visit(s, apply);
     }
 };
 
@@ -272,12 +346,12 @@ template <typename ...Args> struct append_single<variant<Args...>>
  *  @param[in] [unamed] - unused index_sequence for type deduction of I.
  */
 template <typename Tuple, size_t... I>
-void append_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
+int append_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
 {
     auto dbusTypes = utility::tuple_to_array(
             types::type_id<decltype(std::get<I>(t))...>());
 
-    sd_bus_message_append(m, dbusTypes.data(), std::get<I>(t)...);
+    return sd_bus_message_append(m, dbusTypes.data(), std::get<I>(t)...);
 }
 
 /** @brief Append a tuple of 2 or more entries into the sd_bus_message.
@@ -288,10 +362,11 @@ void append_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
  *  A tuple of 2 or more entries can be added as a set with
  *  sd_bus_message_append.
  */
-template <typename Tuple> std::enable_if_t<2 <= std::tuple_size<Tuple>::value>
+template <typename Tuple>
+std::enable_if_t<2 <= std::tuple_size<Tuple>::value, int>
 append_tuple(sd_bus_message* m, Tuple&& t)
 {
-    append_tuple(m, std::move(t),
+    return append_tuple(m, std::move(t),
                  std::make_index_sequence<std::tuple_size<Tuple>::value>());
 }
 
@@ -305,19 +380,22 @@ append_tuple(sd_bus_message* m, Tuple&& t)
  *  Note: Some 1-entry tuples may need special handling due to
  *  can_append_multiple::value == false.
  */
-template <typename Tuple> std::enable_if_t<1 == std::tuple_size<Tuple>::value>
+template <typename Tuple>
+std::enable_if_t<1 == std::tuple_size<Tuple>::value, int>
 append_tuple(sd_bus_message* m, Tuple&& t)
 {
     using itemType = decltype(std::get<0>(t));
-    append_single_t<itemType>::op(m, std::forward<itemType>(std::get<0>(t)));
+    return append_single_t<itemType>::op(
+            m, std::forward<itemType>(std::get<0>(t)));
 }
 
 /** @brief Append a tuple of 0 entries - no-op.
  *
  *  This a no-op function that is useful due to variadic templates.
  */
-template <typename Tuple> std::enable_if_t<0 == std::tuple_size<Tuple>::value>
-inline append_tuple(sd_bus_message* m, Tuple&& t) {}
+template <typename Tuple>
+std::enable_if_t<0 == std::tuple_size<Tuple>::value, int>
+inline append_tuple(sd_bus_message* m, Tuple&& t) { return 0; }
 
 /** @brief Group a sequence of C++ types for appending into an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -326,7 +404,8 @@ inline append_tuple(sd_bus_message* m, Tuple&& t) {}
  *  Specialization for when can_append_multiple<Arg> is true.
  */
 template <typename Tuple, typename Arg> std::enable_if_t<
-        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
 /** @brief Group a sequence of C++ types for appending into an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -335,7 +414,8 @@ append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
  *  Specialization for when can_append_multiple<Arg> is false.
  */
 template <typename Tuple, typename Arg> std::enable_if_t<
-        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
 /** @brief Group a sequence of C++ types for appending into an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -345,7 +425,8 @@ append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
  *  Specialization for when can_append_multiple<Arg> is true.
  */
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
 /** @brief Group a sequence of C++ types for appending into an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -355,64 +436,83 @@ append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
  *  Specialization for when can_append_multiple<Arg> is false.
  */
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
 
 template <typename Tuple, typename Arg> std::enable_if_t<
-        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg)
 {
     // Last element of a sequence and can_append_multiple, so add it to
     // the tuple and call append_tuple.
 
-    append_tuple(m, std::tuple_cat(std::forward<Tuple>(t),
-                                   std::forward_as_tuple(
-                                        std::forward<Arg>(arg))));
+    return append_tuple(m, std::tuple_cat(std::forward<Tuple>(t),
+                                          std::forward_as_tuple(
+                                               std::forward<Arg>(arg))));
 }
 
 template <typename Tuple, typename Arg> std::enable_if_t<
-        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg)
 {
     // Last element of a sequence but !can_append_multiple, so call
     // append_tuple on the previous elements and separately this single
     // element.
 
-    append_tuple(m, std::forward<Tuple>(t));
-    append_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
+    auto r = append_tuple(m, std::forward<Tuple>(t));
+    if (r < 0)
+    {
+        return r;
+    }
+    return append_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
 }
 
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest)
 {
     // Not the last element of a sequence and can_append_multiple, so add it
     // to the tuple and keep grouping.
 
-    append_grouping(m, std::tuple_cat(std::forward<Tuple>(t),
-                                      std::forward_as_tuple(
-                                            std::forward<Arg>(arg))),
-                    std::forward<Rest>(rest)...);
+    return append_grouping(m, std::tuple_cat(std::forward<Tuple>(t),
+                                             std::forward_as_tuple(
+                                                   std::forward<Arg>(arg))),
+                           std::forward<Rest>(rest)...);
 }
 
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_append_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 append_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest)
 {
     // Not the last element of a sequence but !can_append_multiple, so call
     // append_tuple on the previous elements and separately this single
     // element and then group the remaining elements.
 
-    append_tuple(m, std::forward<Tuple>(t));
-    append_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
-    append_grouping(m, std::make_tuple(), std::forward<Rest>(rest)...);
+    auto r = append_tuple(m, std::forward<Tuple>(t));
+    if (r < 0)
+    {
+        return r;
+    }
+    r = append_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
+    if (r < 0)
+    {
+        return r;
+    }
+    return append_grouping(m, std::make_tuple(), std::forward<Rest>(rest)...);
 }
 
 } // namespace details
 
-template <typename ...Args> void append(sd_bus_message* m, Args&&... args)
+template <typename ...Args> int append(sd_bus_message* m, Args&&... args)
 {
-    details::append_grouping(m, std::make_tuple(), std::forward<Args>(args)...);
+    auto r = details::append_grouping(m, std::make_tuple(),
+                                      std::forward<Args>(args)...);
+    return (r < 0) ? r : 0;
 }
 
 } // namespace message
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cerrno>
 #include <tuple>
 #include <sdbusplus/message/types.hpp>
 #include <sdbusplus/utility/type_traits.hpp>
@@ -17,7 +18,7 @@ namespace message
  *  (This is an empty no-op function that is useful in some cases for
  *   variadic template reasons.)
  */
-inline void read(sd_bus_message* m) {};
+inline int read(sd_bus_message* m) { return 0; };
 /** @brief Read data from an sdbus message.
  *
  *  @param[in] msg - The message to read from.
@@ -28,12 +29,24 @@ inline void read(sd_bus_message* m) {};
  *  C++ values and call the sd_bus_message_read functions with the
  *  appropriate type parameters.  It may also do conversions, where needed,
  *  to convert C++ types into C representations (eg. string, vector).
+ *
+ *  @return 0, or a negative errno at the first failure, after which the
+ *          remaining arguments are not read.  Reading past the end of the
+ *          message or of a container fails with -ENXIO.
  */
-template <typename ...Args> void read(sd_bus_message* m, Args&&... args);
+template <typename ...Args> int read(sd_bus_message* m, Args&&... args);
 
 namespace details
 {
 
+/** @brief Convert the result of an sd_bus_message_read* call, which is 0 at
+ *         the end of the message or container, to 0 or a negative errno.
+ */
+inline int read_result(int r)
+{
+    return (r > 0) ? 0 : ((r == 0) ? -ENXIO : r);
+}
+
 /** @struct can_read_multiple
  *  @brief Utility to identify C++ types that may not be grouped into a
  *         single sd_bus_message_read call and instead need special
@@ -95,10 +108,12 @@ template<typename S> struct read_single
      *
      *  @param[in] m - sd_bus_message to read from.
      *  @param[out] t - The reference to read item into.
+     *
+     *  @return 0, or a negative errno.
      */
     template<typename T,
              typename = std::enable_if_t<std::is_same<S, Td<T>>::value>>
-    static void op(sd_bus_message* m, T&& t)
+    static int op(sd_bus_message* m, T&& t)
     {
         // For this default implementation, we need to ensure that only
         // basic types are used.
@@ -107,7 +122,7 @@ template<typename S> struct read_single
                       "Non-basic types are not allowed.");
 
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
-        sd_bus_message_read_basic(m, dbusType, &t);
+        return read_result(sd_bus_message_read_basic(m, dbusType, &t));
     }
 };
 
@@ -118,12 +133,17 @@ template<typename T> using read_single_t =
 template <> struct read_single<std::string>
 {
     template<typename T>
-    static void op(sd_bus_message* m, T&& s)
+    static int op(sd_bus_message* m, T&& s)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
         const char* str = nullptr;
-        sd_bus_message_read_basic(m, dbusType, &str);
+        auto r = read_result(sd_bus_message_read_basic(m, dbusType, &str));
+        if (r < 0)
+        {
+            return r;
+        }
         s = str;
+        return 0;
     }
 };
 
@@ -131,12 +151,17 @@ template <> struct read_single<std::string>
 template <typename T> struct read_single<details::string_wrapper<T>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<S>());
         const char* str = nullptr;
-        sd_bus_message_read_basic(m, dbusType, &str);
+        auto r = read_result(sd_bus_message_read_basic(m, dbusType, &str));
+        if (r < 0)
+        {
+            return r;
+        }
         s.str = str;
+        return 0;
     }
 };
 
@@ -145,12 +170,13 @@ template <typename T> struct read_single<details::string_wrapper<T>>
 template <> struct read_single<bool>
 {
     template<typename T>
-    static void op(sd_bus_message* m, T&& b)
+    static int op(sd_bus_message* m, T&& b)
     {
         constexpr auto dbusType = std::get<0>(types::type_id<T>());
         int i = 0;
-        sd_bus_message_read_basic(m, dbusType, &i);
+        auto r = read_result(sd_bus_message_read_basic(m, dbusType, &i));
         b = (i != 0);
+        return r;
     }
 };
 
@@ -159,21 +185,34 @@ template <> struct read_single<bool>
 template <typename T> struct read_single<std::vector<T>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         s.clear();
 
         constexpr auto dbusType = utility::tuple_to_array(types::type_id<T>());
-        sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, dbusType.data());
+        auto r = read_result(sd_bus_message_enter_container(
+                m, SD_BUS_TYPE_ARRAY, dbusType.data()));
+        if (r < 0)
+        {
+            return r;
+        }
 
-        while(!sd_bus_message_at_end(m, false))
+        while ((r = sd_bus_message_at_end(m, false)) == 0)
         {
             std::remove_const_t<T> t{};
-            sdbusplus::message::read(m, t);
+            r = sdbusplus::message::read(m, t);
+            if (r < 0)
+            {
+                return r;
+            }
             s.push_back(std::move(t));
         }
+        if (r < 0)
+        {
+            return r;
+        }
 
-        sd_bus_message_exit_container(m);
+        return read_result(sd_bus_message_exit_container(m));
     }
 };
 
@@ -181,16 +220,24 @@ template <typename T> struct read_single<std::vector<T>>
 template <typename T1, typename T2> struct read_single<std::pair<T1, T2>>
 {
     template <typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(
                 std::tuple_cat(types::type_id_nonull<T1>(),
                                types::type_id<T2>()));
 
-        sd_bus_message_enter_container(
-                m, SD_BUS_TYPE_DICT_ENTRY, dbusType.data());
-        sdbusplus::message::read(m, s.first, s.second);
-        sd_bus_message_exit_container(m);
+        auto r = read_result(sd_bus_message_enter_container(
+                m, SD_BUS_TYPE_DICT_ENTRY, dbusType.data()));
+        if (r < 0)
+        {
+            return r;
+        }
+        r = sdbusplus::message::read(m, s.first, s.second);
+        if (r < 0)
+        {
+            return r;
+        }
+        return read_result(sd_bus_message_exit_container(m));
     }
 };
 
@@ -198,23 +245,36 @@ template <typename T1, typename T2> struct read_single<std::pair<T1, T2>>
 template <typename T1, typename T2> struct read_single<std::map<T1, T2>>
 {
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         s.clear();
 
         constexpr auto dbusType = utility::tuple_to_array(
                 types::type_id<typename std::map<T1, T2>::value_type>());
 
-        sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, dbusType.data());
+        auto r = read_result(sd_bus_message_enter_container(
+                m, SD_BUS_TYPE_ARRAY, dbusType.data()));
+        if (r < 0)
+        {
+            return r;
+        }
 
-        while(!sd_bus_message_at_end(m, false))
+        while ((r = sd_bus_message_at_end(m, false)) == 0)
         {
             std::pair<std::remove_const_t<T1>, std::remove_const_t<T2>> p{};
-            sdbusplus::message::read(m, p);
+            r = sdbusplus::message::read(m, p);
+            if (r < 0)
+            {
+                return r;
+            }
             s.insert(std::move(p));
         }
+        if (r < 0)
+        {
+            return r;
+        }
 
-        sd_bus_message_exit_container(m);
+        return read_result(sd_bus_message_exit_container(m));
     }
 };
 
@@ -222,25 +282,32 @@ template <typename T1, typename T2> struct read_single<std::map<T1, T2>>
 template <typename ...Args> struct read_single<std::tuple<Args...>>
 {
     template<typename S, std::size_t... I>
-    static void _op(sd_bus_message* m, S&& s,
-                    std::integer_sequence<std::size_t, I...>)
+    static int _op(sd_bus_message* m, S&& s,
+                   std::integer_sequence<std::size_t, I...>)
     {
-        sdbusplus::message::read(m, std::get<I>(s)...);
+        return sdbusplus::message::read(m, std::get<I>(s)...);
     }
 
     template<typename S>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(std::tuple_cat(
                 types::type_id_nonull<Args...>(),
                 std::make_tuple('\0') /* null terminator for C-string */));
 
-        sd_bus_message_enter_container(
-                m, SD_BUS_TYPE_STRUCT, dbusType.data());
-        _op(m, std::forward<S>(s),
-            std::make_index_sequence<sizeof...(Args)>());
-        sd_bus_message_exit_container(m);
-
+        auto r = read_result(sd_bus_message_enter_container(
+                m, SD_BUS_TYPE_STRUCT, dbusType.data()));
+        if (r < 0)
+        {
+            return r;
+        }
+        r = _op(m, std::forward<S>(s),
+                std::make_index_sequence<sizeof...(Args)>());
+        if (r < 0)
+        {
+            return r;
+        }
+        return read_result(sd_bus_message_exit_container(m));
     }
 };
 
@@ -248,7 +315,7 @@ template <typename ...Args> struct read_single<std::tuple<Args...>>
 template <typename ...Args> struct read_single<variant<Args...>>
 {
     template<typename S, typename S1, typename ...Args1>
-    static void read(sd_bus_message* m, S&& s)
+    static int read(sd_bus_message* m, S&& s)
     {
         constexpr auto dbusType = utility::tuple_to_array(types::type_id<S1>());
 
@@ -257,31 +324,40 @@ template <typename ...Args> struct read_single<variant<Args...>>
                                              dbusType.data());
         if (0 >= rc)
         {
-            read<S, Args1...>(m, s);
-            return;
+            return read<S, Args1...>(m, s);
         }
 
         std::remove_reference_t<S1> s1;
 
-        sd_bus_message_enter_container(m, SD_BUS_TYPE_VARIANT, dbusType.data());
-        sdbusplus::message::read(m, s1);
-        sd_bus_message_exit_container(m);
+        auto r = read_result(sd_bus_message_enter_container(
+                m, SD_BUS_TYPE_VARIANT, dbusType.data()));
+        if (r < 0)
+        {
+            return r;
+        }
+        r = sdbusplus::message::read(m, s1);
+        if (r < 0)
+        {
+            return r;
+        }
+        r = read_result(sd_bus_message_exit_container(m));
 
         s = std::move(s1);
+        return r;
     }
 
     template<typename S>
-    static void read(sd_bus_message* m, S&& s)
+    static int read(sd_bus_message* m, S&& s)
     {
-        sd_bus_message_skip(m, "v");
         s = std::remove_reference_t<S>{};
+        return read_result(sd_bus_message_skip(m, "v"));
     }
 
     template<typename S,
              typename = std::enable_if_t<0 < sizeof...(Args)>>
-    static void op(sd_bus_message* m, S&& s)
+    static int op(sd_bus_message* m, S&& s)
     {
-        read<S, Args...>(m, s);
+        return read<S, Args...>(m, s);
     }
 };
 
@@ -293,12 +369,13 @@ template <typename ...Args> struct read_single<variant<Args...>>
  *  @param[in] [unamed] - unused index_sequence for type deduction of I.
  */
 template <typename Tuple, size_t... I>
-void read_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
+int read_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
 {
     auto dbusTypes = utility::tuple_to_array(
             types::type_id<decltype(std::get<I>(t))...>());
 
-    sd_bus_message_read(m, dbusTypes.data(), &std::get<I>(t)...);
+    return read_result(
+            sd_bus_message_read(m, dbusTypes.data(), &std::get<I>(t)...));
 }
 
 /** @brief Read a tuple of 2 or more entries from the sd_bus_message.
@@ -309,10 +386,11 @@ void read_tuple(sd_bus_message* m, Tuple&& t, std::index_sequence<I...>)
  *  A tuple of 2 or more entries can be read as a set with
  *  sd_bus_message_read.
  */
-template <typename Tuple> std::enable_if_t<2 <= std::tuple_size<Tuple>::value>
+template <typename Tuple>
+std::enable_if_t<2 <= std::tuple_size<Tuple>::value, int>
 read_tuple(sd_bus_message* m, Tuple&& t)
 {
-    read_tuple(m, std::move(t),
+    return read_tuple(m, std::move(t),
                std::make_index_sequence<std::tuple_size<Tuple>::value>());
 }
 
@@ -326,19 +404,22 @@ read_tuple(sd_bus_message* m, Tuple&& t)
  *  Note: Some 1-entry tuples may need special handling due to
  *  can_read_multiple::value == false.
  */
-template <typename Tuple> std::enable_if_t<1 == std::tuple_size<Tuple>::value>
+template <typename Tuple>
+std::enable_if_t<1 == std::tuple_size<Tuple>::value, int>
 read_tuple(sd_bus_message* m, Tuple&& t)
 {
     using itemType = decltype(std::get<0>(t));
-    read_single_t<itemType>::op(m, std::forward<itemType>(std::get<0>(t)));
+    return read_single_t<itemType>::op(m,
+                                       std::forward<itemType>(std::get<0>(t)));
 }
 
 /** @brief Read a tuple of 0 entries - no-op.
  *
  *  This a no-op function that is useful due to variadic templates.
  */
-template <typename Tuple> std::enable_if_t<0 == std::tuple_size<Tuple>::value>
-inline read_tuple(sd_bus_message* m, Tuple&& t) {}
+template <typename Tuple>
+std::enable_if_t<0 == std::tuple_size<Tuple>::value, int>
+inline read_tuple(sd_bus_message* m, Tuple&& t) { return 0; }
 
 /** @brief Group a sequence of C++ types for reading from an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -347,7 +428,8 @@ inline read_tuple(sd_bus_message* m, Tuple&& t) {}
  *  Specialization for when can_read_multiple<Arg> is true.
  */
 template <typename Tuple, typename Arg> std::enable_if_t<
-        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
 /** @brief Group a sequence of C++ types for reading from an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -356,7 +438,8 @@ read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
  *  Specialization for when can_read_multiple<Arg> is false.
  */
 template <typename Tuple, typename Arg> std::enable_if_t<
-        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
 /** @brief Group a sequence of C++ types for reading from an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -366,7 +449,8 @@ read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg);
  *  Specialization for when can_read_multiple<Arg> is true.
  */
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
 /** @brief Group a sequence of C++ types for reading from an sd_bus_message.
  *  @tparam Tuple - A tuple of previously analyzed types.
@@ -376,64 +460,82 @@ read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
  *  Specialization for when can_read_multiple<Arg> is false.
  */
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest);
 
 template <typename Tuple, typename Arg> std::enable_if_t<
-        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg)
 {
     // Last element of a sequence and can_read_multiple, so add it to
     // the tuple and call read_tuple.
 
-    read_tuple(m, std::tuple_cat(std::forward<Tuple>(t),
-                                 std::forward_as_tuple(
-                                     std::forward<Arg>(arg))));
+    return read_tuple(m, std::tuple_cat(std::forward<Tuple>(t),
+                                        std::forward_as_tuple(
+                                            std::forward<Arg>(arg))));
 }
 
 template <typename Tuple, typename Arg> std::enable_if_t<
-        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg)
 {
     // Last element of a sequence but !can_read_multiple, so call
     // read_tuple on the previous elements and separately this single
     // element.
 
-    read_tuple(m, std::forward<Tuple>(t));
-    read_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
+    auto r = read_tuple(m, std::forward<Tuple>(t));
+    if (r < 0)
+    {
+        return r;
+    }
+    return read_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
 }
 
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest)
 {
     // Not the last element of a sequence and can_read_multiple, so add it
     // to the tuple and keep grouping.
 
-    read_grouping(m, std::tuple_cat(std::forward<Tuple>(t),
-                                    std::forward_as_tuple(
-                                          std::forward<Arg>(arg))),
-                  std::forward<Rest>(rest)...);
+    return read_grouping(m, std::tuple_cat(std::forward<Tuple>(t),
+                                           std::forward_as_tuple(
+                                                 std::forward<Arg>(arg))),
+                         std::forward<Rest>(rest)...);
 }
 
 template <typename Tuple, typename Arg, typename ...Rest> std::enable_if_t<
-        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value>
+        !can_read_multiple<types::details::type_id_downcast_t<Arg>>::value,
+        int>
 read_grouping(sd_bus_message* m, Tuple&& t, Arg&& arg, Rest&&... rest)
 {
     // Not the last element of a sequence but !can_read_multiple, so call
     // read_tuple on the previous elements and separately this single
     // element and then group the remaining elements.
 
-    read_tuple(m, std::forward<Tuple>(t));
-    read_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
-    read_grouping(m, std::make_tuple(), std::forward<Rest>(rest)...);
+    auto r = read_tuple(m, std::forward<Tuple>(t));
+    if (r < 0)
+    {
+        return r;
+    }
+    r = read_tuple(m, std::forward_as_tuple(std::forward<Arg>(arg)));
+    if (r < 0)
+    {
+        return r;
+    }
+    return read_grouping(m, std::make_tuple(), std::forward<Rest>(rest)...);
 }
 
 } // namespace details
 
-template <typename ...Args> void read(sd_bus_message* m, Args&&... args)
+template <typename ...Args> int read(sd_bus_message* m, Args&&... args)
 {
-    details::read_grouping(m, std::make_tuple(), std::forward<Args>(args)...);
+    return details::read_grouping(m, std::make_tuple(),
+                                  std::forward<Args>(args)...);
 }
 
 } // namespace message
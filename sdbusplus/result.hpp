@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <utility>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message/types.hpp>
+
+namespace sdbusplus
+{
+
+namespace result
+{
+
+/** @class error
+ *  @brief The errno and D-Bus error of a failed sd-bus operation.
+ *
+ *  The error name is the one sent by the remote end for a failed call, or
+ *  the one sd-bus maps the errno to otherwise, such as
+ *  'org.freedesktop.DBus.Error.InvalidArgs' for EINVAL.
+ */
+class error
+{
+    public:
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor, as there is always an error.
+         *         - Copy operations due to the owned sd_bus_error.
+         *     Allowed:
+         *         - Move operations.
+         *         - Destructor.
+         */
+        error() = delete;
+        error(const error&) = delete;
+        error& operator=(const error&) = delete;
+        error(error&& other) : _errnum(other._errnum), _error(other._error)
+        {
+            other._error = sd_bus_error{};
+        }
+        error& operator=(error&& other)
+        {
+            if (this != &other)
+            {
+                sd_bus_error_free(&_error);
+                _errnum = other._errnum;
+                _error = other._error;
+                other._error = sd_bus_error{};
+            }
+            return *this;
+        }
+        ~error()
+        {
+            sd_bus_error_free(&_error);
+        }
+
+        /** @brief Construct from the result of an sd-bus function.
+         *
+         *  @param[in] r - The negative errno returned.
+         */
+        explicit error(int r) : _errnum(std::abs(r))
+        {
+            sd_bus_error_set_errno(&_error, _errnum);
+        }
+
+        /** @brief Construct from the result of an sd-bus call.
+         *
+         *  @param[in] r - The negative errno returned.
+         *  @param[in] e - The error set by the call, which is moved from.
+         */
+        error(int r, sd_bus_error& e) : _errnum(std::abs(r)), _error(e)
+        {
+            e = sd_bus_error{};
+            if (!sd_bus_error_is_set(&_error))
+            {
+                sd_bus_error_set_errno(&_error, _errnum);
+            }
+        }
+
+        /** @brief Get the (positive) errno. */
+        int get_errno() const
+        {
+            return _errnum;
+        }
+
+        /** @brief Get the D-Bus error name. */
+        const char* name() const
+        {
+            return _error.name;
+        }
+
+        /** @brief Get the D-Bus error message, which may be nullptr. */
+        const char* description() const
+        {
+            return _error.message;
+        }
+
+        /** @brief Check the D-Bus error name.
+         *
+         *  @param[in] name - The error name to compare with.
+         */
+        bool has_name(const char* name) const
+        {
+            return sd_bus_error_has_name(&_error, name);
+        }
+
+        /** @brief Throw the error as an exception::SdBusError. */
+        [[noreturn]] void throw_exception() const
+        {
+            throw exception::SdBusError(_errnum, name(), description());
+        }
+
+    private:
+        int _errnum;
+        sd_bus_error _error{};
+};
+
+/** @class result
+ *  @brief The value of an sd-bus operation, or the error it failed with.
+ *
+ *  The non-throwing counterpart of the library calls, for paths where
+ *  failures are expected, such as probing for an optional service:
+ *
+ *      auto reply = bus.try_call(m);
+ *      if (!reply)
+ *      {
+ *          if (reply.get_error().has_name(
+ *                  "org.freedesktop.DBus.Error.ServiceUnknown"))
+ *          ...
+ *      }
+ *
+ *  value() throws the error as an exception::SdBusError instead, for
+ *  callers which prefer exceptions:
+ *
+ *      auto reply = bus.try_call(m).value();
+ *
+ *  @tparam T - The type of the value, or void.
+ */
+template <typename T>
+class result
+{
+    public:
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor, as there is a value or an error.
+         *         - Copy operations, as the error cannot be copied.
+         *     Allowed:
+         *         - Move operations.
+         *         - Destructor.
+         */
+        result() = delete;
+        result(const result&) = delete;
+        result& operator=(const result&) = delete;
+        result(result&&) = default;
+        result& operator=(result&&) = default;
+        ~result() = default;
+
+        /** @brief Construct a result holding a value. */
+        result(T&& value) : _value(std::move(value)) {}
+        /** @brief Construct a result holding an error. */
+        result(error&& e) : _value(std::move(e)) {}
+
+        /** @brief Check if the result holds a value. */
+        bool has_value() const
+        {
+            return _value.template is<T>();
+        }
+
+        explicit operator bool() const
+        {
+            return has_value();
+        }
+
+        /** @brief Get the value, or throw the error.
+         *
+         *  @throws exception::SdBusError if the result holds an error.
+         */
+        T& value() &
+        {
+            check();
+            return _value.template get<T>();
+        }
+
+        /** @copydoc value() */
+        T&& value() &&
+        {
+            check();
+            return std::move(_value.template get<T>());
+        }
+
+        /** @brief Get the value, which the result must hold. */
+        T& operator*()
+        {
+            return _value.template get_unchecked<T>();
+        }
+
+        T* operator->()
+        {
+            return &_value.template get_unchecked<T>();
+        }
+
+        /** @brief Get the error, which the result must hold. */
+        const error& get_error() const
+        {
+            return _value.template get_unchecked<error>();
+        }
+
+    private:
+        message::variant<T, error> _value;
+
+        void check() const
+        {
+            if (!has_value())
+            {
+                get_error().throw_exception();
+            }
+        }
+};
+
+/** @brief Specialization of result for operations without a value. */
+template <>
+class result<void>
+{
+    public:
+        result() = delete;
+        result(const result&) = delete;
+        result& operator=(const result&) = delete;
+        result(result&&) = default;
+        result& operator=(result&&) = default;
+        ~result() = default;
+
+        /** @brief Construct from the result of an sd-bus function.
+         *
+         *  @param[in] r - The value returned, which is an error if negative.
+         */
+        explicit result(int r) : _errnum((r < 0) ? r : 0) {}
+        /** @brief Construct a result holding an error. */
+        result(error&& e) : _errnum(-e.get_errno()), _error(std::move(e)) {}
+
+        /** @brief Check if the operation succeeded. */
+        bool has_value() const
+        {
+            return _errnum == 0;
+        }
+
+        explicit operator bool() const
+        {
+            return has_value();
+        }
+
+        /** @brief Throw the error, if any.
+         *
+         *  @throws exception::SdBusError if the operation failed.
+         */
+        void value() const
+        {
+            if (!has_value())
+            {
+                get_error().throw_exception();
+            }
+        }
+
+        /** @brief Get the error, which the result must hold. */
+        const error& get_error() const
+        {
+            // The name is only looked up when it is asked for.
+            if (!has_value() && !_error.is<error>())
+            {
+                _error = error(_errnum);
+            }
+            return _error.get_unchecked<error>();
+        }
+
+    private:
+        struct none {};
+
+        int _errnum;
+        mutable message::variant<none, error> _error;
+};
+
+} // namespace result
+
+template <typename T>
+using result_t = result::result<T>;
+
+} // namespace sdbusplus
@@ -0,0 +1,29 @@
+#include <sdbusplus/bus/stats.hpp>
+#include <sdbusplus/probe.hpp>
+#include "bindings.hpp"
+
+namespace sdbusplus
+{
+namespace server
+{
+namespace binding
+{
+namespace details
+{
+
+int method_error(sd_bus_message* msg, sd_bus_error* error,
+                 const char* interface, const char* member,
+                 const char* name, const char* description)
+{
+    sd_bus_error_set_const(error, name, description);
+    sdbusplus::bus::stats::details::count_sent(
+            sd_bus_message_get_bus(msg), SD_BUS_MESSAGE_METHOD_ERROR);
+    SDBUSPLUS_PROBE(method__return, sd_bus_message_get_path(msg),
+                    interface, member, -EINVAL);
+    return -EINVAL;
+}
+
+} // namespace details
+} // namespace binding
+} // namespace server
+} // namespace sdbusplus
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <type_traits>
 #include <utility>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/call_stats.hpp>
+#include <sdbusplus/server/transaction.hpp>
 
 namespace sdbusplus
 {
@@ -23,6 +29,99 @@ T&& convertForMessage(T&& t)
     return std::forward<T>(t);
 }
 
+/** The property-specific part of a generated property callback. */
+using property_body_t = void (*)(message::message& m, void* context);
+
+/** @brief Set the transaction id from an incoming message.
+ *
+ *  Overloaded on whether transaction ids are enabled, so that the
+ *  transaction code is only referenced when it is.
+ */
+inline void set_transaction_id(sd_bus_message* m, std::false_type)
+{
+}
+
+inline void set_transaction_id(sd_bus_message* m, std::true_type)
+{
+    sdbusplus::server::transaction::set_id_from_message(m);
+}
+
+/** @brief Fail a generated method callback with an error reply.
+ *
+ *  Shared by the exception handlers of every generated method callback,
+ *  and by the error branch of those generated with --method-errors=result,
+ *  so the error path is compiled once, in the library, rather than once
+ *  per handler.
+ *
+ *  @param[in] msg - The method call.
+ *  @param[out] error - The error to set.
+ *  @param[in] interface - The interface of the method, for the probe.
+ *  @param[in] member - The name of the method, for the probe.
+ *  @param[in] name - The D-Bus error name.
+ *  @param[in] description - The D-Bus error description.
+ *
+ *  @return The value for the callback to return to sd-bus.
+ */
+int method_error(sd_bus_message* msg, sd_bus_error* error,
+                 const char* interface, const char* member,
+                 const char* name, const char* description);
+
+/** @brief Fail a generated method callback, counting the call as failed.
+ *
+ *  @param[in] t - The call statistics timer of the callback.
+ */
+template <bool Stats>
+int method_error(sd_bus_message* msg, sd_bus_error* error,
+                 call_stats::timer<Stats>& t, const char* interface,
+                 const char* member, const char* name,
+                 const char* description)
+{
+    t.failed();
+    return method_error(msg, error, interface, member, name, description);
+}
+
+/** @brief Common part of the generated sd-bus property callbacks.
+ *
+ *  Wraps the message, sets the transaction id, counts the call and converts
+ *  exceptions to sd-bus errors, so each generated callback only supplies
+ *  the code to append or read its own property, and this part is
+ *  instantiated once per program rather than once per property.
+ *
+ *  @tparam Transaction - Whether transaction ids are enabled.
+ *  @tparam Stats - Whether call statistics are enabled.
+ *
+ *  @param[in] msg - The reply to append to or the value to read from.
+ *  @param[in] context - The 'context' registered with the vtable.
+ *  @param[out] error - The error to set on failure.
+ *  @param[in] site - The call statistics of the callback.
+ *  @param[in] body - The property-specific part of the callback.
+ */
+template <bool Transaction, bool Stats>
+int property_callback(sd_bus_message* msg, void* context,
+                      sd_bus_error* error, call_stats::site<Stats>& site,
+                      property_body_t body)
+{
+    call_stats::timer<Stats> t(site);
+
+    try
+    {
+        set_transaction_id(msg, std::integral_constant<bool, Transaction>());
+        auto m = message::message(msg);
+
+        body(m, context);
+    }
+    catch(sdbusplus::internal_exception_t& e)
+    {
+        t.failed();
+        sd_bus_error_set_const(error, e.name(), e.description());
+        sdbusplus::bus::stats::details::count_sent(
+                sd_bus_message_get_bus(msg), SD_BUS_MESSAGE_METHOD_ERROR);
+        return -EINVAL;
+    }
+
+    return true;
+}
+
 }
 }
 }
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <mutex>
+#include "call_stats.hpp"
+
+namespace sdbusplus
+{
+namespace server
+{
+namespace call_stats
+{
+namespace details
+{
+
+thread_local thread_counters* local = nullptr;
+
+namespace
+{
+
+/** The sites and threads with counters, and the counts of exited threads. */
+struct registry
+{
+    std::mutex lock;
+    std::vector<site<true>*> sites;
+    std::vector<thread_counters*> threads;
+    std::vector<stats> retired;
+};
+
+registry& get_registry()
+{
+    // Never destroyed, as threads may still exit after main returns.
+    static auto r = new registry;
+    return *r;
+}
+
+/** @brief Add the counters of one thread to the totals. */
+void add(std::vector<stats>& totals, const thread_counters& t)
+{
+    for (size_t i = 0; i < totals.size(); ++i)
+    {
+        auto c = t.chunks[i / chunk_size].load(std::memory_order_acquire);
+        if (c == nullptr)
+        {
+            continue;
+        }
+
+        auto& x = c[i % chunk_size];
+        auto& s = totals[i];
+        s.calls += x.calls.load(std::memory_order_relaxed);
+        s.errors += x.errors.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < buckets; ++b)
+        {
+            s.latency[b] += x.latency[b].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/** @brief Moves the counts of a thread to the registry when it exits. */
+struct thread_guard
+{
+    ~thread_guard()
+    {
+        auto t = local;
+        if (t == nullptr)
+        {
+            return;
+        }
+
+        auto& r = get_registry();
+        {
+            std::lock_guard<std::mutex> l(r.lock);
+            add(r.retired, *t);
+            r.threads.erase(std::remove(r.threads.begin(), r.threads.end(),
+                                        t),
+                            r.threads.end());
+        }
+
+        local = nullptr;
+        for (auto& c : t->chunks)
+        {
+            delete[] c.load(std::memory_order_relaxed);
+        }
+        delete t;
+    }
+};
+
+} // anonymous namespace
+
+size_t register_site(site<true>& s)
+{
+    auto& r = get_registry();
+    std::lock_guard<std::mutex> l(r.lock);
+
+    // Another thread may have registered it since the caller checked.
+    auto index = s.index.load(std::memory_order_relaxed);
+    if (index != 0)
+    {
+        return index;
+    }
+
+    if (r.sites.size() >= chunk_size * max_chunks)
+    {
+        return 0;
+    }
+
+    r.sites.push_back(&s);
+    r.retired.push_back({ s.interface, s.member, s.type, 0, 0, {} });
+
+    index = r.sites.size();
+    s.index.store(index, std::memory_order_relaxed);
+    return index;
+}
+
+thread_counters* register_thread()
+{
+    static thread_local thread_guard guard;
+    (void)guard;
+
+    auto t = new thread_counters();
+    auto& r = get_registry();
+    {
+        std::lock_guard<std::mutex> l(r.lock);
+        r.threads.push_back(t);
+    }
+
+    local = t;
+    return t;
+}
+
+counters* add_chunk(thread_counters& t, size_t chunk)
+{
+    auto c = new counters[chunk_size]();
+    t.chunks[chunk].store(c, std::memory_order_release);
+    return c;
+}
+
+} // namespace details
+
+std::vector<stats> snapshot()
+{
+    auto& r = details::get_registry();
+    std::lock_guard<std::mutex> l(r.lock);
+
+    auto totals = r.retired;
+    for (auto t : r.threads)
+    {
+        details::add(totals, *t);
+    }
+
+    return totals;
+}
+
+} // namespace call_stats
+} // namespace server
+} // namespace sdbusplus
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sdbusplus
+{
+namespace server
+{
+namespace call_stats
+{
+
+/** Number of buckets in a latency histogram. */
+constexpr size_t buckets = 32;
+
+/** The type of callback the statistics are for. */
+enum class kind
+{
+    method,
+    get,
+    set,
+};
+
+/** @brief The statistics of a method or property, summed over all threads.
+ *
+ *  The latency histogram is log-bucketed: bucket 'i' counts the calls
+ *  which took at least 2^(i-1) but less than 2^i nanoseconds, bucket 0
+ *  counts calls which took less than 1ns, and the last bucket also counts
+ *  all of the slower calls.
+ */
+struct stats
+{
+    const char* interface;
+    const char* member;
+    kind type;
+
+    uint64_t calls;
+    uint64_t errors;
+    std::array<uint64_t, buckets> latency;
+};
+
+/** @brief Get the statistics of every method and property called so far.
+ *
+ *  The counters are read without stopping the threads which update them,
+ *  so a snapshot taken while calls are in progress may be a call or so
+ *  behind, but never inconsistent within a counter.
+ *
+ *  @return The statistics, in the order the callbacks were first called.
+ */
+std::vector<stats> snapshot();
+
+/** @brief Get the histogram bucket for a latency.
+ *
+ *  @param[in] ns - The latency in nanoseconds.
+ */
+constexpr size_t bucket(uint64_t ns)
+{
+    if (ns == 0)
+    {
+        return 0;
+    }
+
+    auto b = static_cast<size_t>(64 - __builtin_clzll(ns));
+    return (b < buckets) ? b : buckets - 1;
+}
+
+/** @brief Estimate a percentile of the latency of a method or property.
+ *
+ *  @param[in] s - The statistics.
+ *  @param[in] q - The fraction of calls, such as 0.99.
+ *
+ *  @return The upper bound in nanoseconds of the bucket which holds the
+ *          percentile, or 0 if there have been no calls.  The last bucket
+ *          has no upper bound, since it also counts every slower call, so
+ *          UINT64_MAX is returned for it.
+ */
+inline uint64_t percentile(const stats& s, double q)
+{
+    uint64_t total = 0;
+    for (auto n : s.latency)
+    {
+        total += n;
+    }
+
+    uint64_t count = 0;
+    for (size_t i = 0; i < buckets; ++i)
+    {
+        count += s.latency[i];
+        if (count > 0 && count >= q * total)
+        {
+            return (i < buckets - 1) ? uint64_t(1) << i : UINT64_MAX;
+        }
+    }
+
+    return 0;
+}
+
+template <bool Enabled>
+struct site;
+
+/** @brief A callback whose calls are not counted. */
+template <>
+struct site<false>
+{
+    constexpr site(const char*, const char*, kind) {}
+};
+
+/** @brief A callback whose calls are counted.
+ *
+ *  The generated bindings define one site per callback, as a static which
+ *  is constant-initialized; it is given an index into the per-thread
+ *  counters the first time it is called.
+ */
+template <>
+struct site<true>
+{
+    constexpr site(const char* interface, const char* member, kind type) :
+        interface(interface), member(member), type(type), index(0)
+    {
+    }
+
+    const char* interface;
+    const char* member;
+    kind type;
+
+    /** One more than the index of the counters, or 0 before registering. */
+    std::atomic<size_t> index;
+};
+
+namespace details
+{
+
+/** The counters of one site, as updated by one thread. */
+struct counters
+{
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> errors;
+    std::array<std::atomic<uint64_t>, buckets> latency;
+};
+
+constexpr size_t chunk_size = 64;
+constexpr size_t max_chunks = 64;
+
+/** The counters of one thread, allocated a chunk of sites at a time. */
+struct thread_counters
+{
+    std::array<std::atomic<counters*>, max_chunks> chunks;
+};
+
+/** The counters of the calling thread, or nullptr before its first call. */
+extern thread_local thread_counters* local;
+
+/** @brief Give a site its index, on its first call.
+ *
+ *  @return One more than the index, or 0 if there are too many sites.
+ */
+size_t register_site(site<true>& s);
+
+/** @brief Create the counters of the calling thread, on its first call. */
+thread_counters* register_thread();
+
+/** @brief Allocate a chunk of counters of the calling thread. */
+counters* add_chunk(thread_counters& t, size_t chunk);
+
+/** @brief Increment a counter only ever written by the calling thread.
+ *
+ *  A plain load and store rather than a read-modify-write, since there are
+ *  no other writers, so there is no locked instruction on the call path.
+ */
+inline void bump(std::atomic<uint64_t>& c)
+{
+    c.store(c.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+}
+
+/** @brief Record a call of a site. */
+inline void record(site<true>& s, uint64_t ns, bool failed)
+{
+    auto index = s.index.load(std::memory_order_relaxed);
+    if (index == 0)
+    {
+        index = register_site(s);
+        if (index == 0)
+        {
+            return;
+        }
+    }
+    --index;
+
+    auto t = local;
+    if (t == nullptr)
+    {
+        t = register_thread();
+    }
+
+    auto chunk = index / chunk_size;
+    auto c = t->chunks[chunk].load(std::memory_order_relaxed);
+    if (c == nullptr)
+    {
+        c = add_chunk(*t, chunk);
+    }
+
+    auto& x = c[index % chunk_size];
+    bump(x.calls);
+    if (failed)
+    {
+        bump(x.errors);
+    }
+    bump(x.latency[bucket(ns)]);
+}
+
+} // namespace details
+
+template <bool Enabled>
+class timer;
+
+/** @brief Timer of an uncounted callback, which does nothing. */
+template <>
+class timer<false>
+{
+    public:
+        explicit timer(site<false>&) {}
+        void failed() {}
+};
+
+/** @brief Time a call of a callback, recording it when going out of scope.
+ *
+ *  The cost is two reads of the monotonic clock and a few increments of
+ *  counters owned by the calling thread.
+ */
+template <>
+class timer<true>
+{
+    public:
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor, as there would be no site.
+         *         - Copy and move operations, as the call would be
+         *           recorded more than once.
+         *     Allowed:
+         *         - Destructor.
+         */
+        timer() = delete;
+        timer(const timer&) = delete;
+        timer& operator=(const timer&) = delete;
+        timer(timer&&) = delete;
+        timer& operator=(timer&&) = delete;
+
+        explicit timer(site<true>& s) :
+            _site(s), _start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~timer()
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _start).count();
+            details::record(_site, static_cast<uint64_t>(ns), _failed);
+        }
+
+        /** @brief Count the call as an error. */
+        void failed()
+        {
+            _failed = true;
+        }
+
+    private:
+        site<true>& _site;
+        std::chrono::steady_clock::time_point _start;
+        bool _failed = false;
+};
+
+} // namespace call_stats
+} // namespace server
+} // namespace sdbusplus
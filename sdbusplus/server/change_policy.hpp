@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+#include <systemd/sd-bus.h>
+#include <systemd/sd-event.h>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/source.hpp>
+
+namespace sdbusplus
+{
+
+namespace server
+{
+
+namespace change_policy
+{
+
+/** @class change_policy
+ *  @brief Filter the PropertiesChanged signals of a numeric property.
+ *
+ *  A change is only signalled once the value has moved away from the last
+ *  signalled value by more than the deadband, and no more often than once
+ *  per minimum interval.  The property itself always holds the latest
+ *  value; only the signal is held back.
+ *
+ *  The deadband is the larger of 'absolute' and 'relative' times the
+ *  magnitude of the last signalled value, so a relative deadband can be
+ *  given an absolute floor for values near zero.  With neither set, every
+ *  change passes the deadband.
+ *
+ *  A change which passes the deadband but arrives within the minimum
+ *  interval is signalled when the interval expires (a trailing flush), so
+ *  the final value of a burst is never lost.  The flush is driven by the
+ *  sd-event loop attached to the bus; without one, it is deferred to the
+ *  next change after the interval has expired.
+ *
+ *  @tparam T - The arithmetic type of the property.
+ */
+template <typename T>
+struct change_policy
+{
+    static_assert(std::is_arithmetic<T>::value &&
+                  !std::is_same<T, bool>::value,
+                  "Change policies only apply to numeric properties.");
+
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy operations due to internal unique_ptr.
+         *         - Move operations due to 'this' being registered as the
+         *           'userdata' of the flush timer.
+         *     Allowed:
+         *         - Destructor.
+         */
+    change_policy() = delete;
+    change_policy(const change_policy&) = delete;
+    change_policy& operator=(const change_policy&) = delete;
+    change_policy(change_policy&&) = delete;
+    change_policy& operator=(change_policy&&) = delete;
+    ~change_policy() = default;
+
+    /** @brief Create the policy for a property of an interface.
+     *
+     *  @param[in] iface - The interface which holds the property.
+     *  @param[in] property - The property name; must outlive the policy.
+     *  @param[in] initial - The initial value of the property.
+     *  @param[in] absolute - Absolute deadband, or 0.
+     *  @param[in] relative - Deadband relative to the signalled value, or 0.
+     *  @param[in] interval - Minimum time between signals in usec, or 0.
+     */
+    change_policy(interface::interface& iface, const char* property,
+                  T initial, double absolute, double relative,
+                  uint64_t interval) :
+        _iface(iface), _property(property),
+        _absolute(absolute), _relative(relative), _interval(interval),
+        _signalled(initial), _latest(initial), _timer(nullptr)
+    {
+    }
+
+    /** @brief Record a new value and signal it if the policy allows.
+     *
+     *  @param[in] value - The new value of the property.
+     */
+    void changed(T value)
+    {
+        _latest = value;
+        if (!exceeds_deadband())
+        {
+            return;
+        }
+
+        auto now = monotonic_now();
+        if (_interval == 0 || now >= _last + _interval)
+        {
+            signal(now);
+            return;
+        }
+
+        schedule_flush(_last + _interval);
+    }
+
+    private:
+        interface::interface& _iface;
+        const char* _property;
+
+        double _absolute;
+        double _relative;
+        uint64_t _interval;
+
+        /** The value in the last signal, which the deadband is relative to. */
+        T _signalled;
+        /** The most recent value, for the trailing flush. */
+        T _latest;
+        /** The time of the last signal, in CLOCK_MONOTONIC usec. */
+        uint64_t _last = 0;
+
+        source::source _timer;
+
+        /** @brief Check if the latest value is outside of the deadband. */
+        bool exceeds_deadband() const
+        {
+            auto delta = std::fabs(static_cast<double>(_latest) -
+                                   static_cast<double>(_signalled));
+            auto band = std::max(
+                    _absolute,
+                    _relative * std::fabs(static_cast<double>(_signalled)));
+
+            // Written so that a change to or from NaN always signals.
+            return (band == 0) ? (_latest != _signalled) : !(delta <= band);
+        }
+
+        /** @brief Signal the latest value now. */
+        void signal(uint64_t now)
+        {
+            if (_timer)
+            {
+                _timer.set_enabled(SD_EVENT_OFF);
+            }
+
+            _signalled = _latest;
+            _last = now;
+            _iface.property_changed(_property);
+        }
+
+        /** @brief Arm the one-shot timer for the trailing flush.
+         *
+         *  @param[in] when - The CLOCK_MONOTONIC usec to fire at.
+         */
+        void schedule_flush(uint64_t when)
+        {
+            if (_timer)
+            {
+                _timer.set_time(when);
+                _timer.set_enabled(SD_EVENT_ONESHOT);
+                return;
+            }
+
+            auto event = sd_bus_get_event(_iface.bus().get());
+            if (event == nullptr)
+            {
+                return;
+            }
+
+            // 1ms accuracy; the sd-event default of 250ms would defeat
+            // short intervals.
+            sd_event_source* s = nullptr;
+            sd_event_add_time(event, &s, CLOCK_MONOTONIC, when, 1000,
+                              flush_callback, this);
+            _timer = decltype(_timer){s};
+        }
+
+        /** @brief sd-event callback for the trailing flush. */
+        static int flush_callback(sd_event_source* s, uint64_t usec,
+                                  void* context)
+        {
+            auto p = static_cast<change_policy*>(context);
+            if (p->exceeds_deadband())
+            {
+                p->signal(monotonic_now());
+            }
+            return 0;
+        }
+
+        static uint64_t monotonic_now()
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000 +
+                   ts.tv_nsec / 1000;
+        }
+};
+
+} // namespace change_policy
+
+template <typename T>
+using change_policy_t = change_policy::change_policy<T>;
+
+} // namespace server
+} // namespace sdbusplus
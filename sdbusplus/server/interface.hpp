@@ -1,8 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <string>
+#include <vector>
 #include <systemd/sd-bus.h>
+#include <systemd/sd-event.h>
+#include <sdbusplus/probe.hpp>
+#include <sdbusplus/server/intern.hpp>
 #include <sdbusplus/slot.hpp>
+#include <sdbusplus/source.hpp>
 #include <sdbusplus/vtable.hpp>
 #include <sdbusplus/bus.hpp>
 
@@ -42,8 +49,30 @@ struct interface final
     interface() = delete;
     interface(const interface&) = delete;
     interface& operator=(const interface&) = delete;
-    interface(interface&&) = default;
-    interface& operator=(interface&&) = default;
+    interface(interface&& other) :
+        _path(std::move(other._path)), _interf(std::move(other._interf)),
+        _slot(std::move(other._slot)),
+        _coalesce(other._coalesce), _skip_signals(other._skip_signals),
+        _pending(std::move(other._pending)),
+        _unsignalled(std::move(other._unsignalled)),
+        _flush(std::move(other._flush))
+    {
+        rebind_flush();
+    }
+    interface& operator=(interface&& other)
+    {
+        _path = std::move(other._path);
+        _interf = std::move(other._interf);
+        _slot = std::move(other._slot);
+        _coalesce = other._coalesce;
+        _skip_signals = other._skip_signals;
+        _pending = std::move(other._pending);
+        _unsignalled = std::move(other._unsignalled);
+        _flush = std::move(other._flush);
+        rebind_flush();
+
+        return *this;
+    }
     ~interface() = default;
 
     /** @brief Register the (path, interface, vtable) as a dbus object.
@@ -60,11 +89,11 @@ struct interface final
               const char* interf,
               const sdbusplus::vtable::vtable_t* vtable,
               void* context) :
-        _bus(bus.get()), _path(path), _interf(interf),
-        _slot(nullptr)
+        _path(bus.get(), path), _interf(interf),
+        _slot(nullptr), _flush(nullptr)
     {
         sd_bus_slot* slot = nullptr;
-        sd_bus_add_object_vtable(_bus.get(), &slot, _path.c_str(),
+        sd_bus_add_object_vtable(_path.get(), &slot, _path.c_str(),
                                  _interf.c_str(), vtable, context);
 
         _slot = decltype(_slot){slot};
@@ -77,27 +106,295 @@ struct interface final
      */
     auto new_signal(const char* member)
     {
-        return _bus.new_signal(_path.c_str(), _interf.c_str(), member);
+        return _path.bus().new_signal(_path.c_str(), _interf.c_str(), member);
     }
 
     /** @brief Broadcast a property changed signal.
+     *
+     *  When coalescing is enabled the property is only recorded, and a
+     *  single signal for all recorded properties is sent by the next
+     *  flush_property_changes().  While signals are skipped, the change is
+     *  recorded as by record_property_change() instead.
      *
      *  @param[in] property - The property which changed.
      */
     void property_changed(const char* property)
     {
-        sd_bus_emit_properties_changed(_bus.get(), _path.c_str(),
-                                       _interf.c_str(), property, nullptr);
+        if (_skip_signals)
+        {
+            record_property_change(property);
+            return;
+        }
+
+        if (!_unsignalled.empty())
+        {
+            _unsignalled.erase(std::remove(_unsignalled.begin(),
+                                           _unsignalled.end(), property),
+                               _unsignalled.end());
+        }
+
+        if (!_coalesce)
+        {
+            SDBUSPLUS_PROBE(properties__changed, _path.c_str(),
+                            _interf.c_str(), 1);
+            if (sd_bus_emit_properties_changed(_path.get(), _path.c_str(),
+                                               _interf.c_str(), property,
+                                               nullptr) >= 0)
+            {
+                count_signal();
+            }
+            return;
+        }
+
+        if (std::find(_pending.begin(), _pending.end(), property) ==
+                _pending.end())
+        {
+            _pending.emplace_back(property);
+        }
+        schedule_flush();
+    }
+
+    /** @brief Record a property change without signalling it.
+     *
+     *  The change is held until a later emit_changed() names the property,
+     *  or until the property is signalled by property_changed().
+     *
+     *  @param[in] property - The property which changed.
+     */
+    void record_property_change(const char* property)
+    {
+        if (std::find(_unsignalled.begin(), _unsignalled.end(), property) ==
+                _unsignalled.end())
+        {
+            _unsignalled.emplace_back(property);
+        }
+    }
+
+    /** @brief Record, rather than signal, property changes.
+     *
+     *  While set, property_changed() records the changes for a later
+     *  emit_changed(), so that setters and change policies still decide
+     *  which properties changed.
+     *
+     *  @param[in] skip - True to record changes, false to signal them.
+     *  @return The previous setting.
+     */
+    bool skip_property_signals(bool skip)
+    {
+        std::swap(_skip_signals, skip);
+        return skip;
+    }
+
+    /** @brief Send one signal for recorded, unsignalled property changes.
+     *
+     *  Only properties which were recorded by record_property_change()
+     *  since they were last signalled are included, so properties which
+     *  were set to an unchanged value cost nothing.  Nothing is sent if
+     *  none of them changed.  The signal is subject to coalescing, like
+     *  property_changed().
+     *
+     *  @param[in] names - The properties to signal, or none for all of the
+     *                     recorded ones.
+     */
+    template <typename... Names>
+    void emit_changed(const Names&... names)
+    {
+        std::vector<std::string> changed;
+        if (sizeof...(Names) == 0)
+        {
+            changed = std::move(_unsignalled);
+            _unsignalled.clear();
+        }
+        else
+        {
+            std::array<std::string, sizeof...(Names)> wanted{
+                {std::string(names)...}};
+            for (auto& n : wanted)
+            {
+                auto i = std::find(_unsignalled.begin(), _unsignalled.end(),
+                                   n);
+                if (i != _unsignalled.end())
+                {
+                    changed.emplace_back(std::move(*i));
+                    _unsignalled.erase(i);
+                }
+            }
+        }
+
+        if (changed.empty())
+        {
+            return;
+        }
+
+        if (!_coalesce)
+        {
+            emit_properties_changed(changed);
+            return;
+        }
+
+        for (auto& n : changed)
+        {
+            if (std::find(_pending.begin(), _pending.end(), n) ==
+                    _pending.end())
+            {
+                _pending.emplace_back(std::move(n));
+            }
+        }
+        schedule_flush();
+    }
+
+    /** @brief Enable or disable coalescing of property changed signals.
+     *
+     *  While enabled, property_changed() accumulates names and one
+     *  PropertiesChanged signal is sent for all of them at the end of the
+     *  current sd-event loop iteration, or earlier by an explicit
+     *  flush_property_changes().  If the bus is not attached to an sd-event
+     *  loop, only an explicit flush sends the signal.
+     *
+     *  Disabling coalescing flushes any pending changes.
+     *
+     *  @param[in] enable - True to coalesce, false to signal immediately.
+     */
+    void coalesce_property_changes(bool enable)
+    {
+        _coalesce = enable;
+        if (!enable)
+        {
+            flush_property_changes();
+        }
     }
 
-    bus::bus& bus() { return _bus; }
-    const std::string& path() { return _path; }
+    /** @brief Send one signal for all pending property changes, if any. */
+    void flush_property_changes()
+    {
+        if (_flush)
+        {
+            _flush.set_enabled(SD_EVENT_OFF);
+        }
+
+        if (_pending.empty())
+        {
+            return;
+        }
+
+        auto pending = std::move(_pending);
+        _pending.clear();
+
+        emit_properties_changed(pending);
+    }
+
+    bus::bus& bus() { return _path.bus(); }
+    const std::string& path() { return _path.str(); }
 
     private:
-        bus::bus _bus;
-        std::string _path;
-        std::string _interf;
+        /** The bus and path, shared with the other interfaces of the object
+         *  through the intern pool. */
+        intern::path _path;
+        intern::name _interf;
         slot::slot _slot;
+
+        bool _coalesce = false;
+        bool _skip_signals = false;
+        std::vector<std::string> _pending;
+        /** Properties changed by record_property_change(), not yet
+         *  signalled. */
+        std::vector<std::string> _unsignalled;
+        source::source _flush;
+
+        /** @brief Send one PropertiesChanged signal for a set of properties. */
+        void emit_properties_changed(const std::vector<std::string>& names)
+        {
+            SDBUSPLUS_PROBE(properties__changed, _path.c_str(),
+                            _interf.c_str(), names.size());
+
+            bus::details::Strv strv{names};
+            if (sd_bus_emit_properties_changed_strv(
+                        _path.get(), _path.c_str(), _interf.c_str(),
+                        static_cast<char**>(strv)) >= 0)
+            {
+                count_signal();
+            }
+        }
+
+        /** @brief Count a signal sent, if the bus keeps statistics. */
+        void count_signal()
+        {
+            sdbusplus::bus::stats::details::count_sent(_path.get(),
+                                                       SD_BUS_MESSAGE_SIGNAL);
+        }
+
+        /** @brief Arm a one-shot defer source to flush at the end of the
+         *         current event loop iteration.
+         */
+        void schedule_flush()
+        {
+            if (_flush)
+            {
+                _flush.set_enabled(SD_EVENT_ONESHOT);
+                return;
+            }
+
+            auto event = sd_bus_get_event(_path.get());
+            if (event == nullptr)
+            {
+                return;
+            }
+
+            sd_event_source* s = nullptr;
+            sd_event_add_defer(event, &s, flush_callback, this);
+            _flush = decltype(_flush){s};
+        }
+
+        /** @brief Point the flush source back at 'this' after a move. */
+        void rebind_flush()
+        {
+            if (_flush)
+            {
+                _flush.set_userdata(this);
+            }
+        }
+
+        /** @brief sd-event callback for the deferred flush. */
+        static int flush_callback(sd_event_source* s, void* context)
+        {
+            static_cast<interface*>(context)->flush_property_changes();
+            return 0;
+        }
+};
+
+/** @class skip_signals
+ *  @brief Record, rather than signal, the property changes of an interface
+ *         for the lifetime of this object.
+ */
+struct skip_signals
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy and move operations, as the setting is restored
+         *           on destruction.
+         *     Allowed:
+         *         - Destructor.
+         */
+    skip_signals() = delete;
+    skip_signals(const skip_signals&) = delete;
+    skip_signals& operator=(const skip_signals&) = delete;
+    skip_signals(skip_signals&&) = delete;
+    skip_signals& operator=(skip_signals&&) = delete;
+
+    explicit skip_signals(interface& iface) :
+        _iface(iface), _previous(iface.skip_property_signals(true))
+    {
+    }
+
+    ~skip_signals()
+    {
+        _iface.skip_property_signals(_previous);
+    }
+
+    private:
+        interface& _iface;
+        bool _previous;
 };
 
 } // namespace interface
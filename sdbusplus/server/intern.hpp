@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+
+namespace sdbusplus
+{
+
+namespace server
+{
+
+namespace intern
+{
+
+namespace details
+{
+
+/** @brief Reference-counted pool of unique keys, each with a value.
+ *
+ *  Entries are created on the first acquire of a key and erased when the
+ *  last reference is released.  Entries live in a std::map, so pointers to
+ *  them stay valid until they are erased.
+ *
+ *  The pool is only touched when handles are created, copied or destroyed,
+ *  which happens when objects are constructed or torn down, so a single
+ *  mutex is sufficient.  Keys are looked up by a non-owning form, so that
+ *  acquiring an existing entry does not allocate, and only holds the mutex
+ *  for the lookup.
+ *
+ *  @tparam Key - The key type.
+ *  @tparam Value - The value type.
+ *  @tparam Less - A transparent comparison of Key and the lookup forms.
+ */
+template <typename Key, typename Value, typename Less>
+struct pool
+{
+    struct entry
+    {
+        template <typename... Args>
+        explicit entry(Args&&... args) :
+            refs(0), value(std::forward<Args>(args)...) {}
+
+        size_t refs;
+        Value value;
+    };
+
+    using map_t = std::map<Key, entry, Less>;
+    using value_type = typename map_t::value_type;
+
+    /** @brief Find or create the entry for a key and take a reference.
+     *
+     *  @param[in] lookup - The key, in a form comparable by 'Less' and from
+     *                      which a Key can be constructed.
+     *  @param[in] args - Arguments to construct the value if the key is new.
+     */
+    template <typename Lookup, typename... Args>
+    static value_type* acquire(const Lookup& lookup, Args&&... args)
+    {
+        auto& s = storage();
+        std::lock_guard<std::mutex> guard(s.lock);
+
+        auto i = s.entries.find(lookup);
+        if (i == s.entries.end())
+        {
+            i = s.entries.emplace(std::piecewise_construct,
+                                  std::forward_as_tuple(Key(lookup)),
+                                  std::forward_as_tuple(
+                                      std::forward<Args>(args)...)).first;
+        }
+        ++i->second.refs;
+
+        return &*i;
+    }
+
+    /** @brief Take an additional reference on an entry. */
+    static void ref(value_type* e)
+    {
+        auto& s = storage();
+        std::lock_guard<std::mutex> guard(s.lock);
+
+        ++e->second.refs;
+    }
+
+    /** @brief Release a reference, erasing the entry if it was the last. */
+    static void release(value_type* e)
+    {
+        auto& s = storage();
+        std::lock_guard<std::mutex> guard(s.lock);
+
+        if (--e->second.refs == 0)
+        {
+            s.entries.erase(e->first);
+        }
+    }
+
+    private:
+        struct data
+        {
+            std::mutex lock;
+            map_t entries;
+        };
+
+        /** @brief Get the pool storage.
+         *
+         *  Intentionally leaked so that handles held by other static
+         *  objects remain valid during static destruction.
+         */
+        static data& storage()
+        {
+            static auto d = new data();
+            return *d;
+        }
+};
+
+/** @brief Copyable, reference-counted handle to a pool entry. */
+template <typename Pool>
+class handle
+{
+    public:
+        handle(const handle& other) : _entry(other._entry)
+        {
+            if (_entry)
+            {
+                Pool::ref(_entry);
+            }
+        }
+
+        handle& operator=(const handle& other)
+        {
+            if (this != &other)
+            {
+                reset();
+                _entry = other._entry;
+                if (_entry)
+                {
+                    Pool::ref(_entry);
+                }
+            }
+            return *this;
+        }
+
+        handle(handle&& other) : _entry(other._entry)
+        {
+            other._entry = nullptr;
+        }
+
+        handle& operator=(handle&& other)
+        {
+            if (this != &other)
+            {
+                reset();
+                _entry = other._entry;
+                other._entry = nullptr;
+            }
+            return *this;
+        }
+
+        ~handle()
+        {
+            reset();
+        }
+
+    protected:
+        explicit handle(typename Pool::value_type* e) : _entry(e) {}
+
+        typename Pool::value_type* _entry;
+
+    private:
+        void reset()
+        {
+            if (_entry)
+            {
+                Pool::release(_entry);
+                _entry = nullptr;
+            }
+        }
+};
+
+/** Placeholder value for pools which only intern their keys. */
+struct none {};
+
+/** @brief A non-owning string, for looking up keys without a copy. */
+struct view
+{
+    explicit view(const char* s) : data(s), size(strlen(s)) {}
+
+    operator std::string() const { return std::string(data, size); }
+
+    const char* data;
+    size_t size;
+};
+
+/** @brief Compare interned strings with views, in std::string order. */
+struct name_less
+{
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const
+    {
+        return compare(data(a), size(a), data(b), size(b)) < 0;
+    }
+
+    static const char* data(const std::string& s) { return s.data(); }
+    static const char* data(const view& s) { return s.data; }
+    static size_t size(const std::string& s) { return s.size(); }
+    static size_t size(const view& s) { return s.size; }
+
+    static int compare(const char* a, size_t a_size,
+                       const char* b, size_t b_size)
+    {
+        auto r = memcmp(a, b, std::min(a_size, b_size));
+        if (r != 0)
+        {
+            return r;
+        }
+        return (a_size < b_size) ? -1 : (a_size > b_size);
+    }
+};
+
+using path_key = std::pair<sd_bus*, std::string>;
+using path_lookup = std::pair<sd_bus*, view>;
+
+/** @brief Compare interned (bus, path) pairs with (bus, view) pairs. */
+struct path_less
+{
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const
+    {
+        if (a.first != b.first)
+        {
+            return std::less<sd_bus*>()(a.first, b.first);
+        }
+        return name_less()(a.second, b.second);
+    }
+};
+
+using name_pool = pool<std::string, none, name_less>;
+using path_pool = pool<path_key, bus::bus, path_less>;
+
+} // namespace details
+
+/** @class name
+ *  @brief Interned, immutable string such as a dbus interface name.
+ *
+ *  All names with the same value share a single copy of the string.
+ */
+struct name : details::handle<details::name_pool>
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *     Allowed:
+         *         - Copy operations, which share the interned string.
+         *         - Move operations.
+         *         - Destructor.
+         */
+    name() = delete;
+    name(const name&) = default;
+    name& operator=(const name&) = default;
+    name(name&&) = default;
+    name& operator=(name&&) = default;
+    ~name() = default;
+
+    /** @brief Intern a string.
+     *
+     *  @param[in] value - The string to intern.
+     */
+    explicit name(const char* value) :
+        handle(details::name_pool::acquire(details::view(value))) {}
+
+    const std::string& str() const { return _entry->first; }
+    const char* c_str() const { return _entry->first.c_str(); }
+};
+
+/** @class path
+ *  @brief Interned (bus, object path) pair.
+ *
+ *  All holders of the same path on the same bus, such as the interfaces of
+ *  a composed object and the object itself, share a single copy of the
+ *  path and a single reference to the bus.
+ */
+struct path : details::handle<details::path_pool>
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *     Allowed:
+         *         - Copy operations, which share the interned path.
+         *         - Move operations.
+         *         - Destructor.
+         */
+    path() = delete;
+    path(const path&) = default;
+    path& operator=(const path&) = default;
+    path(path&&) = default;
+    path& operator=(path&&) = default;
+    ~path() = default;
+
+    /** @brief Intern a path on a bus.
+     *
+     *  @param[in] bus - The bus the path resides on.
+     *  @param[in] value - The object path.
+     */
+    path(sd_bus* bus, const char* value) :
+        handle(details::path_pool::acquire(
+                    details::path_lookup(bus, details::view(value)),
+                    bus)) {}
+
+    /** @brief Get the shared bus reference. */
+    bus::bus& bus() { return _entry->second.value; }
+    /** @brief Get the bus-pointer, ex. for sd_bus_* calls. */
+    sd_bus* get() const { return _entry->first.first; }
+
+    const std::string& str() const { return _entry->first.second; }
+    const char* c_str() const { return _entry->first.second.c_str(); }
+};
+
+} // namespace intern
+} // namespace server
+} // namespace sdbusplus
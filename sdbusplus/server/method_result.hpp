@@ -0,0 +1,172 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <sdbusplus/exception.hpp>
+
+namespace sdbusplus
+{
+
+namespace server
+{
+
+namespace method_result
+{
+
+namespace details
+{
+
+/** @brief Check if 'T' has static 'errName' and 'errDesc' strings. */
+template <typename T, typename = void>
+struct has_static_names : std::false_type {};
+
+template <typename T>
+struct has_static_names<T, std::enable_if_t<
+        std::is_convertible<decltype(&T::errName), const char* const*>::value &&
+        std::is_convertible<decltype(&T::errDesc), const char* const*>::value>>
+    : std::true_type {};
+
+/** @brief Check if 'E' is an error with static name and description, such
+ *         as the errors generated by sdbus++.
+ *
+ *  Errors with per-instance names, such as exception::SdBusError, cannot
+ *  be returned and must be thrown instead.
+ */
+template <typename E>
+using is_error = std::integral_constant<bool,
+        std::is_base_of<sdbusplus::exception_t, std::decay_t<E>>::value &&
+        has_static_names<std::decay_t<E>>::value>;
+
+/** @class error
+ *  @brief The D-Bus error a method failed with, if any.
+ *
+ *  Only the name and description of the error are kept.  These are the
+ *  'errName' and 'errDesc' constants of the error type, so they are
+ *  static and the callback can reply with them without copying.
+ */
+class error
+{
+    public:
+        error() = default;
+
+        template <typename E,
+                  typename = std::enable_if_t<is_error<E>::value>>
+        error(const E&) :
+            _name(std::decay_t<E>::errName),
+            _description(std::decay_t<E>::errDesc)
+        {
+        }
+
+        /** @brief Check if the method succeeded. */
+        bool has_value() const
+        {
+            return _name == nullptr;
+        }
+
+        explicit operator bool() const
+        {
+            return has_value();
+        }
+
+        /** @brief Get the D-Bus error name, if the method failed. */
+        const char* name() const
+        {
+            return _name;
+        }
+
+        /** @brief Get the D-Bus error description, if the method failed. */
+        const char* description() const
+        {
+            return _description;
+        }
+
+    private:
+        const char* _name = nullptr;
+        const char* _description = nullptr;
+};
+
+} // namespace details
+
+/** @class method_result
+ *  @brief The value returned by a method handler, or the error it failed
+ *         with.
+ *
+ *  Handlers generated with 'sdbus++ --method-errors=result' return this
+ *  rather than throwing their errors, so that methods which often fail
+ *  do not pay for unwinding an exception:
+ *
+ *      method_result_t<int64_t> divide(int64_t x, int64_t y) override
+ *      {
+ *          if (y == 0)
+ *          {
+ *              return Error::DivisionByZero();
+ *          }
+ *          return x / y;
+ *      }
+ *
+ *  The generated callback replies with the error directly.  Exceptions
+ *  thrown by the handler are still caught and replied with as before.
+ *
+ *  @tparam T - The type of the value returned, or void.
+ */
+template <typename T>
+class method_result : public details::error
+{
+    public:
+        /** @brief Construct a result holding a value. */
+        template <typename U,
+                  typename = std::enable_if_t<
+                        std::is_convertible<U, T>::value &&
+                        !details::is_error<U>::value>>
+        method_result(U&& value) : _value(std::forward<U>(value))
+        {
+        }
+
+        /** @brief Construct a result holding an error. */
+        template <typename E,
+                  typename = std::enable_if_t<details::is_error<E>::value>,
+                  typename = void>
+        method_result(const E& e) : details::error(e)
+        {
+        }
+
+        /** @brief Get the value, which is only set if the method succeeded.
+         */
+        T& operator*()
+        {
+            return _value;
+        }
+
+        T* operator->()
+        {
+            return &_value;
+        }
+
+    private:
+        T _value{};
+};
+
+/** @brief Specialization of method_result for methods without a value. */
+template <>
+class method_result<void> : public details::error
+{
+    public:
+        /** @brief Construct a successful result. */
+        method_result() = default;
+
+        /** @brief Construct a result holding an error. */
+        template <typename E,
+                  typename = std::enable_if_t<details::is_error<E>::value>>
+        method_result(const E& e) : details::error(e)
+        {
+        }
+};
+
+} // namespace method_result
+
+template <typename T>
+using method_result_t = method_result::method_result<T>;
+
+} // namespace server
+
+} // namespace sdbusplus
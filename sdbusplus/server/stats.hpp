@@ -0,0 +1,171 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/server/call_stats.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+namespace sdbusplus
+{
+
+namespace server
+{
+
+namespace stats
+{
+
+/** The name of the interface. */
+constexpr auto interface_name = "xyz.openbmc_project.sdbusplus.Stats";
+
+/** @class stats
+ *  @brief Export the performance statistics of a service on the bus.
+ *
+ *  Adds the 'xyz.openbmc_project.sdbusplus.Stats' interface at a path,
+ *  so that tools can read the statistics of any service the same way:
+ *
+ *      sdbusplus::server::stats_t stats{bus, "/xyz/openbmc_project/stats"};
+ *
+ *  The properties are read-only and computed when read, so they never
+ *  signal changes:
+ *
+ *      - Connection (a{st}): The counters of bus::get_stats(), by name.
+ *        Statistics are enabled on the bus by the constructor.
+ *      - Methods (a(sssttttt)): For each method, property get and property
+ *        set called so far: the interface, member, kind ("method", "get"
+ *        or "set"), calls, errors, and the 50th, 90th and 99th percentile
+ *        latency in nanoseconds, rounded up to a power of two, or
+ *        UINT64_MAX for latencies of 2^30ns or more.  These are only
+ *        collected by bindings generated with --enable-call-stats.
+ *      - Matches (t): The signal matches registered in the process.
+ *      - MatchCallbacks (t): The match callbacks run in the process.
+ */
+struct stats
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy operations due to the registered interface.
+         *         - Move operations due to 'this' being registered as the
+         *           'context' with sdbus.
+         *     Allowed:
+         *         - Destructor.
+         */
+    stats() = delete;
+    stats(const stats&) = delete;
+    stats& operator=(const stats&) = delete;
+    stats(stats&&) = delete;
+    stats& operator=(stats&&) = delete;
+    ~stats() = default;
+
+    /** @brief Export the statistics of a service.
+     *
+     *  @param[in] bus - The bus the service uses, which must outlive the
+     *                   object, so that the counters it collects are the
+     *                   ones reported.
+     *  @param[in] path - The path to add the interface at.
+     */
+    stats(bus::bus& bus, const char* path) :
+        _bus(bus), _interface(bus, path, interface_name, get_vtable(), this)
+    {
+        _bus.enable_stats();
+    }
+
+    private:
+        bus::bus& _bus;
+        interface::interface _interface;
+
+        static const vtable::vtable_t* get_vtable()
+        {
+            static constexpr vtable::vtable_t v[] = {
+                vtable::start(),
+                vtable::property("Connection", "a{st}", getConnection),
+                vtable::property("Methods", "a(sssttttt)", getMethods),
+                vtable::property("Matches", "t", getMatches),
+                vtable::property("MatchCallbacks", "t", getMatchCallbacks),
+                vtable::end()
+            };
+            return v;
+        }
+
+        static int getConnection(sd_bus*, const char*, const char*,
+                                 const char*, sd_bus_message* reply,
+                                 void* context, sd_bus_error*)
+        {
+            auto s = static_cast<stats*>(context)->_bus.get_stats();
+
+            std::map<std::string, uint64_t> counters = {
+                { "ReceivedCalls", s.received_calls },
+                { "ReceivedSignals", s.received_signals },
+                { "ReceivedReplies", s.received_replies },
+                { "ReceivedErrors", s.received_errors },
+                { "SentCalls", s.sent_calls },
+                { "SentSignals", s.sent_signals },
+                { "SentReplies", s.sent_replies },
+                { "SentErrors", s.sent_errors },
+                { "FailedCalls", s.failed_calls },
+                { "CallTimeNs", s.call_time },
+                { "QueuedRead", s.queued_read },
+                { "QueuedWrite", s.queued_write },
+                { "ProcessCalls", s.process_calls },
+                { "ProcessTimeNs", s.process_time },
+                { "EmptyWakeups", s.empty_wakeups },
+            };
+
+            message::message(reply).append(counters);
+            return 1;
+        }
+
+        static int getMethods(sd_bus*, const char*, const char*,
+                              const char*, sd_bus_message* reply, void*,
+                              sd_bus_error*)
+        {
+            static const char* const kinds[] = { "method", "get", "set" };
+
+            std::vector<std::tuple<std::string, std::string, std::string,
+                                   uint64_t, uint64_t, uint64_t, uint64_t,
+                                   uint64_t>> methods;
+            for (const auto& s : call_stats::snapshot())
+            {
+                methods.emplace_back(
+                        s.interface, s.member,
+                        kinds[static_cast<size_t>(s.type)],
+                        s.calls, s.errors,
+                        call_stats::percentile(s, 0.5),
+                        call_stats::percentile(s, 0.9),
+                        call_stats::percentile(s, 0.99));
+            }
+
+            message::message(reply).append(methods);
+            return 1;
+        }
+
+        static int getMatches(sd_bus*, const char*, const char*,
+                              const char*, sd_bus_message* reply, void*,
+                              sd_bus_error*)
+        {
+            uint64_t n = bus::match::details::get_counters().registered;
+            return sd_bus_message_append_basic(reply, 't', &n);
+        }
+
+        static int getMatchCallbacks(sd_bus*, const char*, const char*,
+                                     const char*, sd_bus_message* reply,
+                                     void*, sd_bus_error*)
+        {
+            uint64_t n = bus::match::details::get_counters().callbacks;
+            return sd_bus_message_append_basic(reply, 't', &n);
+        }
+};
+
+} // namespace stats
+
+using stats_t = stats::stats;
+
+} // namespace server
+} // namespace sdbusplus
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/slot.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdbusplus/bus.hpp>
+
+namespace sdbusplus
+{
+
+namespace server
+{
+
+namespace subtree
+{
+
+/** @class subtree
+ *  @brief Serve one interface for every object below a path prefix.
+ *
+ *  Wraps sd_bus_add_fallback_vtable and sd_bus_add_node_enumerator so that
+ *  a single registration serves an interface for all objects under a
+ *  prefix.  Objects are resolved on demand: for each incoming call the
+ *  user-provided lookup maps the object path to the 'context' handed to
+ *  the vtable callbacks, or to nullptr if no such object exists.  The
+ *  enumerator lists the existing object paths, and is only used for
+ *  introspection and ObjectManager queries.
+ *
+ *  Unlike server::interface, there is no per-object slot, bus reference or
+ *  path string, so memory use scales with the user's own data rather than
+ *  with the number of objects.
+ *
+ *  The lookup and enumerator are called from within sd-bus, so exceptions
+ *  they throw are not propagated; the call fails with -ENOMEM for
+ *  std::bad_alloc and -EINVAL for any other exception.
+ */
+struct subtree
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy operations due to internal unique_ptr.
+         *     Allowed:
+         *         - Move operations.
+         *         - Destructor.
+         */
+    subtree() = delete;
+    subtree(const subtree&) = delete;
+    subtree& operator=(const subtree&) = delete;
+    subtree(subtree&&) = default;
+    subtree& operator=(subtree&&) = default;
+    ~subtree() = default;
+
+    /** Functor to resolve an object path to its vtable 'context'. */
+    using lookup_t = std::function<void*(const char* path)>;
+    /** Functor to list the object paths below a prefix. */
+    using enumerator_t =
+            std::function<std::vector<std::string>(const char* prefix)>;
+
+    /** @brief Register the (prefix, interface, vtable) as a subtree.
+     *
+     *  @param[in] bus - The bus to register on.
+     *  @param[in] prefix - The path prefix to serve.
+     *  @param[in] interf - The interface to serve.
+     *  @param[in] vtable - The vtable to register.
+     *  @param[in] lookup - Resolves a path to the context passed to the
+     *                      vtable callbacks, or nullptr if not found.
+     *  @param[in] enumerator - Optional functor to list the object paths.
+     */
+    subtree(sdbusplus::bus::bus& bus,
+            const char* prefix,
+            const char* interf,
+            const sdbusplus::vtable::vtable_t* vtable,
+            lookup_t lookup,
+            enumerator_t enumerator = nullptr) :
+        _callbacks(std::make_unique<callbacks>(
+                        callbacks{std::move(lookup), std::move(enumerator)})),
+        _slot(nullptr), _enumerator_slot(nullptr)
+    {
+        sd_bus_slot* slot = nullptr;
+        sd_bus_add_fallback_vtable(bus.get(), &slot, prefix, interf, vtable,
+                                   find, _callbacks.get());
+        _slot = decltype(_slot){slot};
+
+        if (_callbacks->enumerator)
+        {
+            slot = nullptr;
+            sd_bus_add_node_enumerator(bus.get(), &slot, prefix, enumerate,
+                                       _callbacks.get());
+            _enumerator_slot = decltype(_enumerator_slot){slot};
+        }
+    }
+
+    private:
+        struct callbacks
+        {
+            lookup_t lookup;
+            enumerator_t enumerator;
+        };
+
+        std::unique_ptr<callbacks> _callbacks;
+        slot::slot _slot;
+        slot::slot _enumerator_slot;
+
+        /** @brief sd-bus callback to resolve a path to its context. */
+        static int find(sd_bus* bus, const char* path, const char* interface,
+                        void* context, void** found, sd_bus_error* error)
+        {
+            auto c = static_cast<callbacks*>(context);
+
+            try
+            {
+                *found = c->lookup(path);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return -ENOMEM;
+            }
+            catch (...)
+            {
+                return -EINVAL;
+            }
+            return (*found != nullptr) ? 1 : 0;
+        }
+
+        /** @brief sd-bus callback to list the paths below a prefix. */
+        static int enumerate(sd_bus* bus, const char* prefix, void* context,
+                             char*** nodes, sd_bus_error* error)
+        {
+            auto c = static_cast<callbacks*>(context);
+
+            std::vector<std::string> paths;
+            try
+            {
+                paths = c->enumerator(prefix);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return -ENOMEM;
+            }
+            catch (...)
+            {
+                return -EINVAL;
+            }
+
+            // sd-bus takes ownership of the strv and releases it with free().
+            auto strv = static_cast<char**>(
+                    calloc(paths.size() + 1, sizeof(char*)));
+            if (strv == nullptr)
+            {
+                return -ENOMEM;
+            }
+
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                strv[i] = strdup(paths[i].c_str());
+                if (strv[i] == nullptr)
+                {
+                    for (size_t j = 0; j < i; ++j)
+                    {
+                        free(strv[j]);
+                    }
+                    free(strv);
+                    return -ENOMEM;
+                }
+            }
+
+            *nodes = strv;
+            return 0;
+        }
+};
+
+} // namespace subtree
+
+using subtree_t = subtree::subtree;
+
+} // namespace server
+} // namespace sdbusplus
@@ -1,3 +1,5 @@
+#include <atomic>
+#include <ctime>
 #include "transaction.hpp"
 
 namespace sdbusplus
@@ -12,7 +14,50 @@ namespace details
 // Transaction Id
 thread_local uint64_t id = 0;
 
+// Call tracer
+static std::atomic<call_tracer_t> tracer{nullptr};
+
+static uint64_t monotonic_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint64_t call_start()
+{
+    if (tracer.load(std::memory_order_relaxed) == nullptr)
+    {
+        return 0;
+    }
+    return monotonic_now();
+}
+
+void call_end(sd_bus_message* m, uint64_t start)
+{
+    auto t = tracer.load(std::memory_order_relaxed);
+    if (t == nullptr || start == 0)
+    {
+        return;
+    }
+
+    // The message is only sealed, and given a cookie, once it is sent.
+    uint64_t cookie = 0;
+    if (sd_bus_message_get_cookie(m, &cookie) < 0)
+    {
+        return;
+    }
+
+    t({ get_id(), message_id(m), start, monotonic_now() });
+}
+
 } // namespace details
+
+void set_call_tracer(call_tracer_t t)
+{
+    details::tracer.store(t, std::memory_order_relaxed);
+}
+
 } // namespace transaction
 } // namespace server
 } // namespace sdbusplus
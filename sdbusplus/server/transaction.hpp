@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <thread>
+#include <systemd/sd-bus.h>
 #include <sdbusplus/bus.hpp>
 
 namespace sdbusplus
@@ -131,6 +134,165 @@ inline void set_id(uint64_t value)
     details::id = value;
 }
 
+namespace details
+{
+
+/** @brief boost::hash_combine() algorithm. */
+inline uint64_t hash_combine(uint64_t h1, uint64_t h2)
+{
+    return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+/** @brief FNV-1a hash of a bus name. */
+inline uint64_t name_hash(const char* name)
+{
+    uint64_t h = 0xcbf29ce484222325;
+    for (auto p = name; p && *p; ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 0x100000001b3;
+    }
+    return h;
+}
+
+/** @brief The hash of the last name looked up, cached by its contents.
+ *
+ *  The name is compared rather than its address, since the address of a
+ *  freed name may be handed out again for a different one.  D-Bus names
+ *  are at most 255 characters, so a copy fits in the cache.
+ */
+struct name_cache
+{
+    uint64_t get(const char* name)
+    {
+        if (!name)
+        {
+            name = "";
+        }
+
+        auto len = strlen(name);
+        if (len == length && memcmp(name, copy, len) == 0)
+        {
+            return hash;
+        }
+
+        hash = name_hash(name);
+        length = sizeof(copy);
+        if (len < sizeof(copy))
+        {
+            memcpy(copy, name, len);
+            length = len;
+        }
+        return hash;
+    }
+
+    char copy[256] = {};
+    size_t length = sizeof(copy);
+    uint64_t hash = 0;
+};
+
+/** @brief Get a hash of a connection's unique name.
+ *
+ *  The hash of the last connection used by the thread is cached.  The cache
+ *  is keyed on the contents of the unique name, so a new connection which
+ *  reuses the address of a freed one, or of its name, is not mistaken for
+ *  it.
+ */
+inline uint64_t bus_hash(sd_bus* b)
+{
+    static thread_local name_cache c;
+
+    const char* name = nullptr;
+    sd_bus_get_unique_name(b, &name);
+
+    return c.get(name);
+}
+
+/** @brief Get the start time of an outgoing call, if it is being traced.
+ *
+ *  @return The CLOCK_MONOTONIC time in usec, or 0 without a call tracer.
+ */
+uint64_t call_start();
+
+/** @brief Report an outgoing call to the call tracer, if there is one.
+ *
+ *  @param[in] m - The method_call message, after it has been sent.
+ *  @param[in] start - The value from call_start().
+ */
+void call_end(sd_bus_message* m, uint64_t start);
+
+} // namespace details
+
+/** @brief Get the transaction id of a method call.
+ *
+ *  The id combines the hash of the sender's unique name with the cookie of
+ *  the message, which together identify the message on the bus.  A message
+ *  without a sender has not passed through the broker yet, so it is one of
+ *  our own and the connection's unique name is used instead; this way the
+ *  caller and the receiving server derive the same id for a call.
+ *
+ *  Only the hash of our own connection's name is cached.  The sender of a
+ *  received message is hashed on every call: unique names are short, and
+ *  in bench/server/transaction.cpp a cache compare cost as much as the
+ *  hash.
+ *
+ *  @param[in] m - The method_call message.
+ *
+ *  @return The transaction id.
+ */
+inline uint64_t message_id(sd_bus_message* m)
+{
+    uint64_t cookie = 0;
+    sd_bus_message_get_cookie(m, &cookie);
+
+    auto sender = sd_bus_message_get_sender(m);
+    auto h = sender ? details::name_hash(sender) :
+                      details::bus_hash(sd_bus_message_get_bus(m));
+
+    return details::hash_combine(h, cookie);
+}
+
+/** @brief Set the transaction id for the message being handled.
+ *
+ *  The id is the message_id() of the incoming message, so it is computed
+ *  from the cookie and a hash of the sender's short unique name, without
+ *  taking bus references or allocating.  The incoming message is used even
+ *  when 'm' is the reply of a property callback, whose cookie is not yet
+ *  assigned.
+ *
+ *  @param[in] m - The message passed to the callback.
+ */
+inline void set_id_from_message(sd_bus_message* m)
+{
+    auto current = sd_bus_get_current_message(sd_bus_message_get_bus(m));
+    details::id = message_id(current ? current : m);
+}
+
+/** @brief An outgoing call made by bus::call() or bus::call_noreply(). */
+struct call_trace
+{
+    /** The transaction id of the thread making the call. */
+    uint64_t parent;
+    /** The transaction id the server handling the call will use. */
+    uint64_t child;
+    /** CLOCK_MONOTONIC usec when the call was made. */
+    uint64_t start;
+    /** CLOCK_MONOTONIC usec when the call returned. */
+    uint64_t end;
+};
+
+using call_tracer_t = void (*)(const call_trace&);
+
+/** @brief Set the function to report outgoing calls to.
+ *
+ *  Each traced call links the transaction of the caller to the transaction
+ *  of the server handling the call, so with the timestamps the calls made
+ *  across services can be assembled into a tree.  The tracer is called on
+ *  the thread which made the call, after it has returned.
+ *
+ *  @param[in] tracer - The function, or nullptr to stop tracing.
+ */
+void set_call_tracer(call_tracer_t tracer);
+
 } // namespace transaction
 } // namespace server
 } // namespace sdbusplus
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <systemd/sd-event.h>
+
+namespace sdbusplus
+{
+
+namespace source
+{
+
+using sourcep_t = sd_event_source*;
+class source;
+
+namespace details
+{
+
+/** @brief unique_ptr functor to release an event source reference. */
+struct SourceDeleter
+{
+    void operator()(sourcep_t ptr) const
+    {
+        sd_event_source_unref(ptr);
+    }
+};
+
+using source = std::unique_ptr<sd_event_source, SourceDeleter>;
+
+} // namespace details
+
+/** @class source
+ *  @brief Provides C++ holder for sd_event_source instances.
+ */
+struct source
+{
+        /* Define all of the basic class operations:
+         *     Not allowed:
+         *         - Default constructor to avoid nullptrs.
+         *         - Copy operations due to internal unique_ptr.
+         *     Allowed:
+         *         - Move operations.
+         *         - Destructor.
+         */
+    source() = delete;
+    source(const source&) = delete;
+    source& operator=(const source&) = delete;
+    source(source&&) = default;
+    source& operator=(source&&) = default;
+    ~source() = default;
+
+    /** @brief Conversion constructor for 'sourcep_t'.
+     *
+     *  Takes ownership of the source-pointer and releases it when done.
+     */
+    explicit source(sourcep_t s) : _source(s) {}
+
+    /** @brief Release ownership of the stored source-pointer. */
+    sourcep_t release() { return _source.release(); }
+
+    /** @brief Check if source contains a real pointer. (non-nullptr). */
+    explicit operator bool() const { return bool(_source); }
+
+    /** @brief Enable, disable or one-shot the event source.
+     *
+     *  @param[in] enabled - SD_EVENT_ON, SD_EVENT_OFF or SD_EVENT_ONESHOT.
+     */
+    void set_enabled(int enabled)
+    {
+        sd_event_source_set_enabled(_source.get(), enabled);
+    }
+
+    /** @brief Change the userdata passed to the source's callback.
+     *
+     *  @param[in] userdata - The new userdata.
+     */
+    void set_userdata(void* userdata)
+    {
+        sd_event_source_set_userdata(_source.get(), userdata);
+    }
+
+    /** @brief Change the expiry of a time event source.
+     *
+     *  @param[in] usec - The new absolute expiry, in usec of the source's
+     *                    clock.
+     */
+    void set_time(uint64_t usec)
+    {
+        sd_event_source_set_time(_source.get(), usec);
+    }
+
+    private:
+        details::source _source;
+
+};
+
+} // namespace source
+} // namespace sdbusplus
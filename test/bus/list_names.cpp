@@ -49,3 +49,16 @@ TEST_F(ListNames, HasDbusServer)
     ASSERT_NE(names.cend(), i);
     EXPECT_EQ(dbus_server, *i);
 }
+
+TEST_F(ListNames, CallbackSeesSameNames)
+{
+    auto names = bus.list_names_acquired();
+
+    std::vector<std::string> seen;
+    bus.list_names_acquired([&seen](const char* name)
+                            {
+                                seen.emplace_back(name);
+                            });
+
+    EXPECT_EQ(names, seen);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/name_owner.hpp>
+
+class NameOwner : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto busName =
+                "xyz.openbmc_project.sdbusplus.test.NameOwner";
+
+        void waitForIt(sdbusplus::bus::name_owner_cache_t& c, bool expected)
+        {
+            for (size_t i = 0; (i < 16) && (c.has_owner(busName) != expected);
+                 ++i)
+            {
+                bus.wait(0);
+                bus.process_discard();
+            }
+        }
+};
+
+TEST_F(NameOwner, UnknownNameHasNoOwner)
+{
+    sdbusplus::bus::name_owner_cache_t c{bus};
+
+    EXPECT_FALSE(c.has_owner(busName));
+    EXPECT_TRUE(c.owner(busName).empty());
+}
+
+TEST_F(NameOwner, DbusServerHasOwner)
+{
+    sdbusplus::bus::name_owner_cache_t c{bus};
+
+    EXPECT_TRUE(c.has_owner("org.freedesktop.DBus"));
+}
+
+TEST_F(NameOwner, UniqueNameOwnsItself)
+{
+    sdbusplus::bus::name_owner_cache_t c{bus};
+    auto unique = bus.get_unique_name();
+
+    EXPECT_EQ(unique, c.owner(unique));
+}
+
+TEST_F(NameOwner, TracksNameOwnerChanged)
+{
+    sdbusplus::bus::name_owner_cache_t c{bus};
+    ASSERT_FALSE(c.has_owner(busName));
+
+    bus.request_name(busName);
+
+    waitForIt(c, true);
+    EXPECT_EQ(bus.get_unique_name(), c.owner(busName));
+}
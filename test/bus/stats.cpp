@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+class Stats : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+        static constexpr auto interf =
+                "xyz.openbmc_project.sdbusplus.test.Stats";
+
+        auto newDBusCall(const char* method)
+        {
+            return bus.new_method_call("org.freedesktop.DBus",
+                                       "/org/freedesktop/DBus",
+                                       "org.freedesktop.DBus", method);
+        }
+
+        static int call(sd_bus_message* m, void*, sd_bus_error*)
+        {
+            sdbusplus::message::message(m).new_method_return()
+                    .method_return();
+            return 1;
+        }
+
+        static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+            sdbusplus::vtable::start(),
+            sdbusplus::vtable::method("Call", "", "", call),
+            sdbusplus::vtable::end()
+        };
+
+        void processAll()
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                bus.wait(1000);
+                bus.process_discard();
+            }
+        }
+};
+
+constexpr sdbusplus::vtable::vtable_t Stats::vtable[];
+
+TEST_F(Stats, DisabledCountsNothing)
+{
+    auto m = newDBusCall("GetId");
+    bus.call(m);
+    processAll();
+
+    auto s = bus.get_stats();
+    EXPECT_EQ(0u, s.sent_calls);
+    EXPECT_EQ(0u, s.received_replies);
+    EXPECT_EQ(0u, s.process_calls);
+    EXPECT_EQ(0u, s.process_time);
+}
+
+TEST_F(Stats, CountsCalls)
+{
+    bus.enable_stats();
+
+    auto m = newDBusCall("GetId");
+    bus.call(m);
+
+    auto bad = newDBusCall("NoSuchMethod");
+    bus.call_noreply(bad);
+
+    // A call to a connection which never processes it, so it times out
+    // without a reply.
+    auto other = sdbusplus::bus::new_default();
+    auto lost = bus.new_method_call(other.get_unique_name().c_str(), path,
+                                    interf, "Call");
+    bus.call_noreply(lost, 10000);
+
+    auto s = bus.get_stats();
+    EXPECT_EQ(3u, s.sent_calls);
+    EXPECT_EQ(1u, s.received_replies);
+    EXPECT_EQ(1u, s.received_errors);
+    EXPECT_EQ(1u, s.failed_calls);
+    EXPECT_LT(0u, s.call_time);
+}
+
+TEST_F(Stats, CountsSent)
+{
+    bus.enable_stats();
+
+    auto signal = bus.new_signal(path, interf, "Signal");
+    signal.signal_send();
+
+    // Answer a call from another connection.
+    sdbusplus::server::interface_t iface{bus, path, interf, vtable, this};
+    auto other = sdbusplus::bus::new_default();
+    auto call = other.new_method_call(bus.get_unique_name().c_str(), path,
+                                      interf, "Call");
+    call.method_return();
+
+    // Flush the call by making one to the broker after it.
+    auto ping = other.new_method_call("org.freedesktop.DBus",
+                                      "/org/freedesktop/DBus",
+                                      "org.freedesktop.DBus", "GetId");
+    other.call(ping);
+
+    processAll();
+
+    auto s = bus.get_stats();
+    EXPECT_EQ(1u, s.sent_signals);
+    EXPECT_EQ(1u, s.sent_replies);
+    EXPECT_EQ(0u, s.sent_errors);
+}
+
+TEST_F(Stats, SharedByBusObjectsOfAConnection)
+{
+    bus.enable_stats();
+
+    // The message holds the connection, and get_bus() makes a new bus
+    // object for it.
+    auto m = newDBusCall("GetId");
+    auto same = m.get_bus();
+    same.call(m);
+
+    EXPECT_EQ(1u, bus.get_stats().sent_calls);
+    EXPECT_EQ(1u, same.get_stats().sent_calls);
+
+    // Another connection does not have statistics enabled.
+    auto other = sdbusplus::bus::new_default();
+    auto o = other.new_method_call("org.freedesktop.DBus",
+                                   "/org/freedesktop/DBus",
+                                   "org.freedesktop.DBus", "GetId");
+    other.call(o);
+    EXPECT_EQ(0u, other.get_stats().sent_calls);
+    EXPECT_EQ(1u, bus.get_stats().sent_calls);
+}
+
+TEST_F(Stats, CountsFromManyThreads)
+{
+    bus.enable_stats();
+
+    // Counting takes no lock of its own, only the shared registry lock.
+    auto m = newDBusCall("GetId").release();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([m]()
+            {
+                for (size_t j = 0; j < 10000; ++j)
+                {
+                    sdbusplus::bus::stats::details::count_sent(m);
+                }
+            });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    sd_bus_message_unref(m);
+
+    EXPECT_EQ(40000u, bus.get_stats().sent_calls);
+}
+
+TEST_F(Stats, CountsReceived)
+{
+    bus.enable_stats();
+
+    sdbusplus::bus::match_t match{bus,
+        sdbusplus::bus::match::rules::type::signal() +
+            sdbusplus::bus::match::rules::interface(interf),
+        [](sdbusplus::message::message&) {}};
+
+    // Settle the messages from connecting, such as NameAcquired.
+    processAll();
+    auto before = bus.get_stats();
+
+    auto signal = bus.new_signal(path, interf, "Signal");
+    signal.signal_send();
+
+    // A method call from another connection, which sd-bus answers with
+    // an error as there is no such object.
+    auto other = sdbusplus::bus::new_default();
+    auto call = other.new_method_call(bus.get_unique_name().c_str(), path,
+                                      interf, "Call");
+    call.method_return();
+
+    // Flush the call by making one to the broker after it.
+    auto ping = other.new_method_call("org.freedesktop.DBus",
+                                      "/org/freedesktop/DBus",
+                                      "org.freedesktop.DBus", "GetId");
+    other.call(ping);
+
+    processAll();
+
+    auto s = bus.get_stats();
+    EXPECT_EQ(1u, s.received_signals - before.received_signals);
+    EXPECT_EQ(1u, s.received_calls - before.received_calls);
+    EXPECT_EQ(0u, s.sent_calls);
+}
+
+TEST_F(Stats, CountsProcessing)
+{
+    bus.enable_stats();
+    processAll();
+
+    auto s = bus.get_stats();
+    EXPECT_EQ(16u, s.process_calls);
+    EXPECT_EQ(0u, s.empty_wakeups);
+}
+
+TEST_F(Stats, EnableTwiceKeepsCounters)
+{
+    bus.enable_stats();
+    auto m = newDBusCall("GetId");
+    bus.call(m);
+
+    bus.enable_stats();
+    EXPECT_EQ(1u, bus.get_stats().sent_calls);
+}
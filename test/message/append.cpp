@@ -333,6 +333,43 @@ void runTests()
         b.call_noreply(m);
     }
 
+    // Test vector of fixed-size types, which is appended as a single array.
+    {
+        auto m = newMethodCall__test(b);
+        std::vector<double> d{ 1.5, 2.5, 3.5 };
+        std::vector<uint16_t> q{};
+        m.append(1, d, q, 2);
+        verifyTypeString = "iadaqi";
+
+        struct verify
+        {
+            static void op(sd_bus_message* m)
+            {
+                int32_t a = 0;
+                sd_bus_message_read(m, "i", &a);
+                assert(a == 1);
+
+                const void* p = nullptr;
+                size_t size = 0;
+                auto rc = sd_bus_message_read_array(m, 'd', &p, &size);
+                assert(0 <= rc);
+                assert(3 * sizeof(double) == size);
+                auto d = static_cast<const double*>(p);
+                assert(1.5 == d[0] && 2.5 == d[1] && 3.5 == d[2]);
+
+                rc = sd_bus_message_read_array(m, 'q', &p, &size);
+                assert(0 <= rc);
+                assert(0 == size);
+
+                sd_bus_message_read(m, "i", &a);
+                assert(a == 2);
+            }
+        };
+        verifyCallback = &verify::op;
+
+        b.call_noreply(m);
+    }
+
     // Test map.
     {
         auto m = newMethodCall__test(b);
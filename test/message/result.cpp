@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+class Result : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        auto newDBusCall(const char* method)
+        {
+            return bus.new_method_call("org.freedesktop.DBus",
+                                       "/org/freedesktop/DBus",
+                                       "org.freedesktop.DBus", method);
+        }
+
+        /** Create a sealed message containing 'args', ready to be read. */
+        template <typename... Args>
+        auto newSealed(Args&&... args)
+        {
+            auto m = newDBusCall("GetId");
+            EXPECT_TRUE(m.try_append(std::forward<Args>(args)...));
+
+            auto p = m.release();
+            sd_bus_message_seal(p, 1, 0);
+            sd_bus_message_rewind(p, true);
+            return sdbusplus::message::message(p, std::false_type());
+        }
+};
+
+TEST_F(Result, ReadRoundTrip)
+{
+    std::map<std::string, std::vector<int32_t>> in = {
+        { "a", { 1, 2, 3 } }, { "b", {} } };
+    auto m = newSealed(int32_t(7), std::string("str"), in);
+
+    int32_t i = 0;
+    std::string s;
+    std::map<std::string, std::vector<int32_t>> out;
+    auto r = m.try_read(i, s, out);
+
+    ASSERT_TRUE(r);
+    EXPECT_EQ(7, i);
+    EXPECT_EQ("str", s);
+    EXPECT_EQ(in, out);
+}
+
+TEST_F(Result, ReadWrongType)
+{
+    auto m = newSealed(int32_t(7));
+
+    std::string s = "unchanged";
+    auto r = m.try_read(s);
+
+    ASSERT_FALSE(r);
+    EXPECT_EQ(ENXIO, r.get_error().get_errno());
+    EXPECT_NE(nullptr, r.get_error().name());
+    EXPECT_EQ("unchanged", s);
+}
+
+TEST_F(Result, ReadPastEnd)
+{
+    auto m = newSealed(int32_t(7));
+
+    int32_t i = 0, j = 0;
+    auto r = m.try_read(i, j);
+
+    ASSERT_FALSE(r);
+    EXPECT_EQ(ENXIO, r.get_error().get_errno());
+    EXPECT_EQ(7, i);
+}
+
+TEST_F(Result, ReadStopsAtFirstFailure)
+{
+    auto m = newSealed(std::vector<std::string>{ "a", "b" }, int32_t(7));
+
+    std::vector<int32_t> v;
+    int32_t i = 0;
+    auto r = m.try_read(v, i);
+
+    EXPECT_FALSE(r);
+    EXPECT_EQ(0, i);
+}
+
+TEST_F(Result, AppendToSealed)
+{
+    auto m = newSealed(int32_t(7));
+
+    auto r = m.try_append(std::string("more"));
+    ASSERT_FALSE(r);
+    EXPECT_EQ(EPERM, r.get_error().get_errno());
+}
+
+TEST_F(Result, ValueThrows)
+{
+    auto m = newSealed(int32_t(7));
+
+    std::string s;
+    try
+    {
+        m.try_read(s).value();
+        FAIL();
+    }
+    catch (const sdbusplus::exception::SdBusError& e)
+    {
+        EXPECT_EQ(ENXIO, e.get_errno());
+        EXPECT_STREQ(m.try_read(s).get_error().name(), e.name());
+    }
+}
+
+TEST_F(Result, Call)
+{
+    auto m = newDBusCall("GetId");
+    auto reply = bus.try_call(m);
+
+    ASSERT_TRUE(reply);
+
+    std::string id;
+    EXPECT_TRUE(reply->try_read(id));
+    EXPECT_FALSE(id.empty());
+}
+
+TEST_F(Result, CallError)
+{
+    auto m = bus.new_method_call("xyz.openbmc_project.sdbusplus.NoService",
+                                 "/", "org.freedesktop.DBus.Peer", "Ping");
+    auto reply = bus.try_call(m);
+
+    ASSERT_FALSE(reply);
+    EXPECT_TRUE(reply.get_error().has_name(
+            "org.freedesktop.DBus.Error.ServiceUnknown"));
+    EXPECT_NE(0, reply.get_error().get_errno());
+    EXPECT_THROW(reply.value(), sdbusplus::exception::SdBusError);
+
+    auto noreply = bus.new_method_call(
+            "xyz.openbmc_project.sdbusplus.NoService", "/",
+            "org.freedesktop.DBus.Peer", "Ping");
+    auto r = bus.try_call_noreply(noreply);
+    ASSERT_FALSE(r);
+    EXPECT_TRUE(r.get_error().has_name(
+            "org.freedesktop.DBus.Error.ServiceUnknown"));
+}
+
+TEST_F(Result, NewMethodCallInvalid)
+{
+    auto m = bus.try_new_method_call("org.freedesktop.DBus", "not a path",
+                                     "org.freedesktop.DBus", "GetId");
+
+    ASSERT_FALSE(m);
+    EXPECT_EQ(EINVAL, m.get_error().get_errno());
+    EXPECT_TRUE(m.get_error().has_name(
+            "org.freedesktop.DBus.Error.InvalidArgs"));
+}
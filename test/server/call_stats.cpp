@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <sdbusplus/server/call_stats.hpp>
+
+namespace call_stats = sdbusplus::server::call_stats;
+
+static constexpr auto interf = "xyz.openbmc_project.sdbusplus.test.Stats";
+
+/** Find the snapshot of a member, or nullptr. */
+static const call_stats::stats* find(const std::vector<call_stats::stats>& v,
+                                     const char* member)
+{
+    auto i = std::find_if(v.begin(), v.end(),
+                          [member](const call_stats::stats& s)
+                          {
+                              return strcmp(s.member, member) == 0;
+                          });
+    return (i == v.end()) ? nullptr : &*i;
+}
+
+static uint64_t total(const call_stats::stats& s)
+{
+    uint64_t n = 0;
+    for (auto b : s.latency)
+    {
+        n += b;
+    }
+    return n;
+}
+
+TEST(CallStats, Buckets)
+{
+    EXPECT_EQ(0u, call_stats::bucket(0));
+    EXPECT_EQ(1u, call_stats::bucket(1));
+    EXPECT_EQ(2u, call_stats::bucket(2));
+    EXPECT_EQ(2u, call_stats::bucket(3));
+    EXPECT_EQ(11u, call_stats::bucket(1024));
+    EXPECT_EQ(call_stats::buckets - 1, call_stats::bucket(UINT64_MAX));
+}
+
+TEST(CallStats, CountsCallsAndErrors)
+{
+    static call_stats::site<true> site{interf, "Counted",
+                                       call_stats::kind::method};
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        call_stats::timer<true> t(site);
+        if (i % 2)
+        {
+            t.failed();
+        }
+    }
+
+    auto snapshot = call_stats::snapshot();
+    auto s = find(snapshot, "Counted");
+    ASSERT_NE(nullptr, s);
+    EXPECT_STREQ(interf, s->interface);
+    EXPECT_EQ(call_stats::kind::method, s->type);
+    EXPECT_EQ(5u, s->calls);
+    EXPECT_EQ(2u, s->errors);
+    EXPECT_EQ(5u, total(*s));
+}
+
+TEST(CallStats, LatencyBucket)
+{
+    static call_stats::site<true> site{interf, "Slow",
+                                       call_stats::kind::get};
+
+    {
+        call_stats::timer<true> t(site);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    auto snapshot = call_stats::snapshot();
+    auto s = find(snapshot, "Slow");
+    ASSERT_NE(nullptr, s);
+
+    // At least 2ms, so at or above the bucket of 2^20ns.
+    auto first = std::find(s->latency.begin(), s->latency.end(), 1u);
+    ASSERT_NE(s->latency.end(), first);
+    EXPECT_LE(21, first - s->latency.begin());
+}
+
+TEST(CallStats, Percentile)
+{
+    call_stats::stats s{interf, "Percentile", call_stats::kind::method, 0, 0,
+                        {}};
+    EXPECT_EQ(0u, call_stats::percentile(s, 0.5));
+
+    // 90 calls under 1us, 9 under 1ms and one of 10s.
+    s.latency[call_stats::bucket(500)] = 90;
+    s.latency[call_stats::bucket(500000)] = 9;
+    s.latency[call_stats::bucket(10000000000)] = 1;
+
+    EXPECT_EQ(512u, call_stats::percentile(s, 0.5));
+    EXPECT_EQ(512u, call_stats::percentile(s, 0.9));
+    EXPECT_EQ(524288u, call_stats::percentile(s, 0.99));
+
+    // The last bucket has no upper bound.
+    EXPECT_EQ(UINT64_MAX, call_stats::percentile(s, 1.0));
+}
+
+TEST(CallStats, SumsOverThreads)
+{
+    static call_stats::site<true> site{interf, "Threaded",
+                                       call_stats::kind::set};
+
+    auto calls = []()
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                call_stats::timer<true> t(site);
+            }
+        };
+
+    // One thread is still running at the snapshot, and one has exited.
+    std::thread exited(calls);
+    exited.join();
+
+    bool ready = false;
+    bool done = false;
+    std::mutex lock;
+    std::condition_variable cv;
+
+    std::thread running([&]()
+        {
+            calls();
+            std::unique_lock<std::mutex> l(lock);
+            ready = true;
+            cv.notify_all();
+            cv.wait(l, [&]() { return done; });
+        });
+
+    {
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [&]() { return ready; });
+    }
+
+    calls();
+    auto snapshot = call_stats::snapshot();
+    auto s = find(snapshot, "Threaded");
+
+    {
+        std::lock_guard<std::mutex> l(lock);
+        done = true;
+        cv.notify_all();
+    }
+    running.join();
+
+    ASSERT_NE(nullptr, s);
+    EXPECT_EQ(3000u, s->calls);
+    EXPECT_EQ(3000u, total(*s));
+
+    // The exited threads' counts are kept.
+    auto after = call_stats::snapshot();
+    EXPECT_EQ(3000u, find(after, "Threaded")->calls);
+}
+
+TEST(CallStats, DisabledIsEmpty)
+{
+    static call_stats::site<false> site{interf, "Disabled",
+                                        call_stats::kind::method};
+    call_stats::timer<false> t(site);
+    t.failed();
+
+    EXPECT_TRUE(std::is_empty<call_stats::timer<false>>::value);
+    auto snapshot = call_stats::snapshot();
+    EXPECT_EQ(nullptr, find(snapshot, "Disabled"));
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/change_policy.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+class ChangePolicy : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+        static constexpr auto interf =
+                "xyz.openbmc_project.sdbusplus.test.ChangePolicy";
+
+        static int getProperty(sd_bus*, const char*, const char*,
+                               const char*, sd_bus_message* reply,
+                               void*, sd_bus_error*)
+        {
+            return sd_bus_message_append_basic(reply, 'd', &value);
+        }
+
+        static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+            sdbusplus::vtable::start(),
+            sdbusplus::vtable::property("Value", "d", getProperty,
+                sdbusplus::vtable::property_::emits_change),
+            sdbusplus::vtable::end()
+        };
+
+        static double value;
+
+        std::vector<double> signals;
+
+        sdbusplus::bus::match_t match{bus,
+            sdbusplus::bus::match::rules::propertiesChanged(path, interf),
+            [this](sdbusplus::message::message& m)
+            {
+                std::string i;
+                std::map<std::string, sdbusplus::message::variant<double>> c;
+                m.read(i, c);
+                signals.push_back(c["Value"].get<double>());
+            }};
+
+        sdbusplus::server::interface_t iface{bus, path, interf, vtable, this};
+
+        /** Update the property and report it to the policy. */
+        template <typename Policy>
+        void set(Policy& policy, double v)
+        {
+            value = v;
+            policy.changed(v);
+        }
+
+        void processAll()
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                bus.wait(1000);
+                bus.process_discard();
+            }
+        }
+};
+
+constexpr sdbusplus::vtable::vtable_t ChangePolicy::vtable[];
+double ChangePolicy::value = 0;
+
+TEST_F(ChangePolicy, AbsoluteDeadband)
+{
+    sdbusplus::server::change_policy_t<double> p{
+        iface, "Value", 0.0, 0.5, 0, 0};
+
+    set(p, 0.1);
+    set(p, 0.3);
+    set(p, 0.7);
+    set(p, 0.9);
+    set(p, 0.1);
+    processAll();
+
+    ASSERT_EQ(2u, signals.size());
+    EXPECT_EQ(0.7, signals[0]);
+    EXPECT_EQ(0.1, signals[1]);
+}
+
+TEST_F(ChangePolicy, RelativeDeadbandWithFloor)
+{
+    sdbusplus::server::change_policy_t<double> p{
+        iface, "Value", 100.0, 1.0, 0.1, 0};
+
+    set(p, 105.0);
+    set(p, 111.0);
+    set(p, 0.0);
+    set(p, 0.5);
+    set(p, 1.5);
+    processAll();
+
+    ASSERT_EQ(3u, signals.size());
+    EXPECT_EQ(111.0, signals[0]);
+    EXPECT_EQ(0.0, signals[1]);
+    EXPECT_EQ(1.5, signals[2]);
+}
+
+TEST_F(ChangePolicy, NoDeadbandSignalsEveryChange)
+{
+    sdbusplus::server::change_policy_t<double> p{
+        iface, "Value", 0.0, 0, 0, 0};
+
+    set(p, 1e-300);
+    set(p, 0.0);
+    processAll();
+
+    EXPECT_EQ(2u, signals.size());
+}
+
+TEST_F(ChangePolicy, IntervalHoldsBackWithoutEventLoop)
+{
+    sdbusplus::server::change_policy_t<double> p{
+        iface, "Value", 0.0, 0, 0, 60000000};
+
+    set(p, 1.0);
+    set(p, 2.0);
+    set(p, 3.0);
+    processAll();
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(1.0, signals[0]);
+}
+
+TEST_F(ChangePolicy, IntervalTrailingFlush)
+{
+    using namespace std::chrono;
+
+    sd_event* event = nullptr;
+    sd_event_new(&event);
+    bus.attach_event(event, SD_EVENT_PRIORITY_NORMAL);
+
+    {
+        sdbusplus::server::change_policy_t<double> p{
+            iface, "Value", 0.0, 0, 0, 50000};
+
+        auto start = steady_clock::now();
+        set(p, 1.0);
+        set(p, 2.0);
+        set(p, 3.0);
+
+        while ((signals.size() < 2) &&
+               (steady_clock::now() - start < seconds(2)))
+        {
+            sd_event_run(event, 10000);
+        }
+        EXPECT_LE(milliseconds(50), steady_clock::now() - start);
+    }
+
+    bus.detach_event();
+    sd_event_unref(event);
+
+    ASSERT_EQ(2u, signals.size());
+    EXPECT_EQ(1.0, signals[0]);
+    EXPECT_EQ(3.0, signals[1]);
+}
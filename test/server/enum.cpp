@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sdbusplus/exception.hpp>
+#include <xyz/openbmc_project/Test/Events/server.hpp>
+
+using Events = sdbusplus::xyz::openbmc_project::Test::server::Events;
+using Reason = Events::Reason;
+using sdbusplus::xyz::openbmc_project::Test::server::convertForMessage;
+
+static constexpr auto prefix = "xyz.openbmc_project.Test.Events.Reason.";
+
+static constexpr auto first = Reason::PowerOn;
+static constexpr auto last = Reason::Unknown;
+
+TEST(Enum, RoundTripsEveryValue)
+{
+    for (auto i = static_cast<int>(first); i <= static_cast<int>(last); ++i)
+    {
+        auto v = static_cast<Reason>(i);
+        std::string s = convertForMessage(v);
+
+        EXPECT_EQ(0u, s.find(prefix)) << s;
+        EXPECT_EQ(v, Events::convertReasonFromString(s)) << s;
+    }
+}
+
+TEST(Enum, QualifiedNames)
+{
+    EXPECT_STREQ("xyz.openbmc_project.Test.Events.Reason.PowerOn",
+                 convertForMessage(Reason::PowerOn));
+    EXPECT_STREQ("xyz.openbmc_project.Test.Events.Reason.Hang",
+                 convertForMessage(Reason::Hang));
+    EXPECT_STREQ("xyz.openbmc_project.Test.Events.Reason.Unknown",
+                 convertForMessage(Reason::Unknown));
+}
+
+TEST(Enum, InvalidStrings)
+{
+    using sdbusplus::exception::InvalidEnumString;
+
+    // Truncated.
+    EXPECT_THROW(Events::convertReasonFromString(
+                         std::string(prefix) + "PowerOf"),
+                 InvalidEnumString);
+    // One character off, at and away from the switched position; Halt and
+    // Hang share a case of the switch.
+    EXPECT_THROW(Events::convertReasonFromString(
+                         std::string(prefix) + "PowerOfg"),
+                 InvalidEnumString);
+    EXPECT_THROW(Events::convertReasonFromString(
+                         std::string(prefix) + "Hant"),
+                 InvalidEnumString);
+    EXPECT_THROW(Events::convertReasonFromString(
+                         std::string(prefix) + "Xalt"),
+                 InvalidEnumString);
+    EXPECT_THROW(Events::convertReasonFromString(
+                         "xyz.openbmc_project.Test.Events.Reasom.Halt"),
+                 InvalidEnumString);
+    // The bare prefix.
+    EXPECT_THROW(Events::convertReasonFromString(prefix), InvalidEnumString);
+    // Unqualified value names.
+    EXPECT_THROW(Events::convertReasonFromString("Halt"), InvalidEnumString);
+    EXPECT_THROW(Events::convertReasonFromString("PowerOn"),
+                 InvalidEnumString);
+    EXPECT_THROW(Events::convertReasonFromString(""), InvalidEnumString);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Test/FinalAccessors/server.hpp>
+
+namespace server = sdbusplus::xyz::openbmc_project::Test::server;
+using Mode = server::FinalAccessors::Mode;
+
+static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test/final";
+static constexpr auto interf = "xyz.openbmc_project.Test.FinalAccessors";
+
+/** Accessors generated with --property-accessors=final. */
+using FinalAccessors = sdbusplus::server::object_t<server::FinalAccessors>;
+
+class FinalAccessorsCallback : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) server =
+                sdbusplus::bus::new_default();
+        decltype(sdbusplus::bus::new_default()) client =
+                sdbusplus::bus::new_default();
+
+        FinalAccessors object{server, path};
+
+        std::string service = server.get_unique_name();
+        std::atomic<bool> stop{false};
+        std::thread thread;
+
+        ~FinalAccessorsCallback()
+        {
+            stop = true;
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        /** @brief Process the server connection on a thread.
+         *
+         *  The connection is not thread-safe, so the object must not be
+         *  changed locally from then on.
+         */
+        void serve()
+        {
+            thread = std::thread([this]
+                {
+                    while (!stop)
+                    {
+                        server.wait(10000);
+                        server.process_discard();
+                    }
+                });
+        }
+
+        template <typename T>
+        T get(const char* property)
+        {
+            auto m = client.new_method_call(service.c_str(), path,
+                                            "org.freedesktop.DBus.Properties",
+                                            "Get");
+            m.append(interf, property);
+            auto reply = client.call(m);
+
+            sdbusplus::message::variant<T> value;
+            reply.read(value);
+            return value.template get<T>();
+        }
+
+        template <typename T>
+        bool set(const char* property, T value)
+        {
+            auto m = client.new_method_call(service.c_str(), path,
+                                            "org.freedesktop.DBus.Properties",
+                                            "Set");
+            m.append(interf, property, sdbusplus::message::variant<T>(value));
+            return bool(client.try_call(m));
+        }
+};
+
+TEST_F(FinalAccessorsCallback, Get)
+{
+    object.count(3);
+    object.label("label");
+    object.mode(Mode::Automatic);
+    object.serial("serial");
+    serve();
+
+    EXPECT_EQ(3u, get<uint32_t>("Count"));
+    EXPECT_EQ("label", get<std::string>("Label"));
+    EXPECT_EQ("xyz.openbmc_project.Test.FinalAccessors.Mode.Automatic",
+              get<std::string>("Mode"));
+    EXPECT_EQ("serial", get<std::string>("Serial"));
+}
+
+TEST_F(FinalAccessorsCallback, Set)
+{
+    serve();
+
+    EXPECT_TRUE(set("Count", uint32_t(5)));
+    EXPECT_TRUE(set("Label", std::string("set")));
+    EXPECT_TRUE(set("Mode", std::string(
+            "xyz.openbmc_project.Test.FinalAccessors.Mode.Automatic")));
+
+    EXPECT_EQ(5u, get<uint32_t>("Count"));
+    EXPECT_EQ("set", get<std::string>("Label"));
+    EXPECT_EQ("xyz.openbmc_project.Test.FinalAccessors.Mode.Automatic",
+              get<std::string>("Mode"));
+
+    // Read by the server thread, so only after the calls above returned.
+    EXPECT_EQ(5u, object.count());
+    EXPECT_EQ("set", object.label());
+    EXPECT_EQ(Mode::Automatic, object.mode());
+}
+
+TEST_F(FinalAccessorsCallback, SetFails)
+{
+    serve();
+
+    EXPECT_FALSE(set("Mode", std::string("Automatic")));
+    EXPECT_FALSE(set("Serial", std::string("serial")));
+
+    EXPECT_EQ(Mode::Manual, object.mode());
+    EXPECT_EQ("", object.serial());
+}
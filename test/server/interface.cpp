@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+class Interface : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+        static constexpr auto interf =
+                "xyz.openbmc_project.sdbusplus.test.Interface";
+
+        static int getProperty(sd_bus*, const char*, const char*,
+                               const char*, sd_bus_message* reply,
+                               void*, sd_bus_error*)
+        {
+            return sd_bus_message_append_basic(reply, 'i', &value);
+        }
+
+        static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+            sdbusplus::vtable::start(),
+            sdbusplus::vtable::property("A", "i", getProperty,
+                sdbusplus::vtable::property_::emits_change),
+            sdbusplus::vtable::property("B", "i", getProperty,
+                sdbusplus::vtable::property_::emits_change),
+            sdbusplus::vtable::end()
+        };
+
+        static int32_t value;
+
+        using changed_t = std::map<std::string,
+                                   sdbusplus::message::variant<int32_t>>;
+        std::vector<changed_t> signals;
+
+        sdbusplus::bus::match_t match{bus,
+            sdbusplus::bus::match::rules::propertiesChanged(path, interf),
+            [this](sdbusplus::message::message& m)
+            {
+                std::string i;
+                changed_t changed;
+                m.read(i, changed);
+                signals.push_back(std::move(changed));
+            }};
+
+        void processAll()
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                bus.wait(1000);
+                bus.process_discard();
+            }
+        }
+};
+
+constexpr sdbusplus::vtable::vtable_t Interface::vtable[];
+int32_t Interface::value = 0;
+
+TEST_F(Interface, ImmediateSignalPerProperty)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+
+    i.property_changed("A");
+    i.property_changed("B");
+    processAll();
+
+    ASSERT_EQ(2u, signals.size());
+    EXPECT_EQ(1u, signals[0].count("A"));
+    EXPECT_EQ(1u, signals[1].count("B"));
+}
+
+TEST_F(Interface, CoalescedUntilFlush)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+    i.coalesce_property_changes(true);
+
+    i.property_changed("A");
+    i.property_changed("B");
+    i.property_changed("A");
+    processAll();
+    EXPECT_TRUE(signals.empty());
+
+    i.flush_property_changes();
+    processAll();
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(2u, signals[0].size());
+    EXPECT_EQ(1u, signals[0].count("A"));
+    EXPECT_EQ(1u, signals[0].count("B"));
+}
+
+TEST_F(Interface, DisableCoalescingFlushes)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+    i.coalesce_property_changes(true);
+
+    i.property_changed("B");
+    i.coalesce_property_changes(false);
+    processAll();
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(1u, signals[0].count("B"));
+}
+
+TEST_F(Interface, CoalescedFlushAtEndOfEventIteration)
+{
+    sd_event* event = nullptr;
+    sd_event_new(&event);
+    bus.attach_event(event, SD_EVENT_PRIORITY_NORMAL);
+
+    {
+        sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+        i.coalesce_property_changes(true);
+
+        i.property_changed("A");
+        i.property_changed("B");
+
+        for (size_t n = 0; (n < 16) && signals.empty(); ++n)
+        {
+            sd_event_run(event, 1000);
+        }
+    }
+
+    bus.detach_event();
+    sd_event_unref(event);
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(2u, signals[0].size());
+}
+
+TEST_F(Interface, RecordedChangesEmittedTogether)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+
+    i.record_property_change("A");
+    i.record_property_change("B");
+    i.record_property_change("A");
+    processAll();
+    EXPECT_TRUE(signals.empty());
+
+    i.emit_changed();
+    i.emit_changed();
+    processAll();
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(2u, signals[0].size());
+}
+
+TEST_F(Interface, EmitChangedOnlyNamedProperties)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+
+    i.record_property_change("A");
+    i.record_property_change("B");
+
+    i.emit_changed("A");
+    i.emit_changed("A");
+    i.emit_changed(std::string("B"), "A");
+    processAll();
+
+    ASSERT_EQ(2u, signals.size());
+    EXPECT_EQ(1u, signals[0].size());
+    EXPECT_EQ(1u, signals[0].count("A"));
+    EXPECT_EQ(1u, signals[1].size());
+    EXPECT_EQ(1u, signals[1].count("B"));
+}
+
+TEST_F(Interface, PropertyChangedClearsRecordedChange)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+
+    i.record_property_change("A");
+    i.property_changed("A");
+    i.emit_changed();
+    processAll();
+
+    ASSERT_EQ(1u, signals.size());
+    EXPECT_EQ(1u, signals[0].count("A"));
+}
+
+TEST_F(Interface, SkippedSignalsAreRecorded)
+{
+    sdbusplus::server::interface_t i{bus, path, interf, vtable, this};
+
+    {
+        sdbusplus::server::interface::skip_signals skip{i};
+        i.property_changed("A");
+        {
+            sdbusplus::server::interface::skip_signals nested{i};
+            i.property_changed("B");
+        }
+        i.property_changed("A");
+    }
+    processAll();
+    EXPECT_TRUE(signals.empty());
+
+    i.emit_changed();
+    i.property_changed("A");
+    processAll();
+
+    ASSERT_EQ(2u, signals.size());
+    EXPECT_EQ(2u, signals[0].size());
+    EXPECT_EQ(1u, signals[1].size());
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/intern.hpp>
+
+using sdbusplus::server::intern::name;
+using sdbusplus::server::intern::path;
+
+static constexpr auto objpath = "/xyz/openbmc_project/sdbusplus/test";
+
+TEST(InternName, EqualValuesShareStorage)
+{
+    name a{"xyz.openbmc_project.sdbusplus.test.A"};
+    name b{"xyz.openbmc_project.sdbusplus.test.A"};
+    name c{"xyz.openbmc_project.sdbusplus.test.C"};
+
+    EXPECT_EQ(a.c_str(), b.c_str());
+    EXPECT_NE(a.c_str(), c.c_str());
+    EXPECT_EQ("xyz.openbmc_project.sdbusplus.test.C", c.str());
+}
+
+TEST(InternName, CopiesAndMovesShareStorage)
+{
+    name a{"xyz.openbmc_project.sdbusplus.test.A"};
+    name b{a};
+    name c{std::move(b)};
+
+    EXPECT_EQ(a.c_str(), c.c_str());
+
+    b = c;
+    EXPECT_EQ(a.c_str(), b.c_str());
+}
+
+TEST(InternPath, SameBusSharesPathAndBus)
+{
+    sd_bus* b = nullptr;
+    sd_bus_open(&b);
+    sdbusplus::bus::bus bus{b, std::false_type()};
+
+    path p1{b, objpath};
+    path p2{b, objpath};
+
+    EXPECT_EQ(p1.c_str(), p2.c_str());
+    EXPECT_EQ(&p1.bus(), &p2.bus());
+    EXPECT_EQ(b, p1.get());
+    EXPECT_EQ(objpath, p1.str());
+}
+
+TEST(InternPath, DifferentBusesAreDistinct)
+{
+    sd_bus* b1 = nullptr;
+    sd_bus* b2 = nullptr;
+    sd_bus_open(&b1);
+    sd_bus_open(&b2);
+    sdbusplus::bus::bus bus1{b1, std::false_type()};
+    sdbusplus::bus::bus bus2{b2, std::false_type()};
+
+    path p1{b1, objpath};
+    path p2{b2, objpath};
+
+    EXPECT_NE(p1.c_str(), p2.c_str());
+    EXPECT_EQ(b1, p1.get());
+    EXPECT_EQ(b2, p2.get());
+}
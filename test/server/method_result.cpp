@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/server/method_result.hpp>
+
+namespace
+{
+
+struct NotFound final : public sdbusplus::exception_t
+{
+    static constexpr auto errName = "xyz.openbmc_project.Test.Error.NotFound";
+    static constexpr auto errDesc = "The key was not found.";
+
+    const char* name() const noexcept override { return errName; }
+    const char* description() const noexcept override { return errDesc; }
+    const char* what() const noexcept override { return errName; }
+};
+
+constexpr const char* NotFound::errName;
+constexpr const char* NotFound::errDesc;
+
+using sdbusplus::server::method_result_t;
+
+method_result_t<std::string> find(bool found)
+{
+    if (!found)
+    {
+        return NotFound();
+    }
+    return "value";
+}
+
+} // namespace
+
+TEST(MethodResult, Value)
+{
+    auto r = find(true);
+
+    ASSERT_TRUE(r);
+    EXPECT_EQ("value", *r);
+    EXPECT_EQ(5u, r->size());
+    EXPECT_EQ(nullptr, r.name());
+}
+
+TEST(MethodResult, Error)
+{
+    auto r = find(false);
+
+    ASSERT_FALSE(r);
+    EXPECT_EQ(NotFound::errName, r.name());
+    EXPECT_EQ(NotFound::errDesc, r.description());
+}
+
+TEST(MethodResult, Tuple)
+{
+    method_result_t<std::tuple<int64_t, std::string>> r =
+            std::make_tuple(int64_t(1), std::string("one"));
+
+    ASSERT_TRUE(r);
+    EXPECT_EQ(1, std::get<0>(*r));
+    EXPECT_EQ("one", std::get<1>(*r));
+}
+
+TEST(MethodResult, Void)
+{
+    method_result_t<void> ok{};
+    EXPECT_TRUE(ok);
+
+    method_result_t<void> failed = NotFound();
+    ASSERT_FALSE(failed);
+    EXPECT_EQ(NotFound::errName, failed.name());
+}
+
+TEST(MethodResult, NotAnError)
+{
+    // Only errors with static names can be returned.
+    EXPECT_FALSE((std::is_constructible<method_result_t<void>,
+                                        std::string>::value));
+    EXPECT_FALSE((std::is_constructible<method_result_t<int64_t>,
+                                        std::string>::value));
+
+    // Nor errors with per-instance names, which must be thrown.
+    EXPECT_FALSE((std::is_constructible<
+                      method_result_t<void>,
+                      sdbusplus::exception::SdBusError>::value));
+    EXPECT_FALSE((std::is_constructible<
+                      method_result_t<std::string>,
+                      sdbusplus::exception::SdBusError>::value));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Test/MethodResult/error.hpp>
+#include <xyz/openbmc_project/Test/MethodResult/server.hpp>
+
+namespace server = sdbusplus::xyz::openbmc_project::Test::server;
+using NotFound =
+        sdbusplus::xyz::openbmc_project::Test::MethodResult::Error::NotFound;
+
+static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test/result";
+static constexpr auto interf = "xyz.openbmc_project.Test.MethodResult";
+
+/** Handlers generated with --method-errors=result. */
+struct MethodResult : sdbusplus::server::object_t<server::MethodResult>
+{
+    using sdbusplus::server::object_t<server::MethodResult>::object;
+
+    sdbusplus::server::method_result_t<std::string> find(
+            std::string key) override
+    {
+        if (key != "present")
+        {
+            return NotFound();
+        }
+        return std::string("value");
+    }
+
+    sdbusplus::server::method_result_t<void> check(std::string key) override
+    {
+        if (key == "throw")
+        {
+            throw NotFound();
+        }
+        if (key != "present")
+        {
+            return NotFound();
+        }
+        return {};
+    }
+};
+
+class MethodResultCallback : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) server =
+                sdbusplus::bus::new_default();
+        decltype(sdbusplus::bus::new_default()) client =
+                sdbusplus::bus::new_default();
+
+        MethodResult object{server, path};
+
+        std::string service = server.get_unique_name();
+        std::atomic<bool> stop{false};
+        std::thread thread{[this]
+            {
+                while (!stop)
+                {
+                    server.wait(10000);
+                    server.process_discard();
+                }
+            }};
+
+        ~MethodResultCallback()
+        {
+            stop = true;
+            thread.join();
+        }
+
+        auto call(const char* method, const char* key)
+        {
+            auto m = client.new_method_call(service.c_str(), path, interf,
+                                            method);
+            m.append(key);
+            return client.try_call(m);
+        }
+};
+
+TEST_F(MethodResultCallback, ReturnsValue)
+{
+    auto reply = call("Find", "present");
+    ASSERT_TRUE(reply);
+
+    std::string value;
+    reply->read(value);
+    EXPECT_EQ("value", value);
+}
+
+TEST_F(MethodResultCallback, RepliesWithReturnedError)
+{
+    auto reply = call("Find", "absent");
+    ASSERT_FALSE(reply);
+    EXPECT_TRUE(reply.get_error().has_name(NotFound::errName));
+    EXPECT_STREQ(NotFound::errDesc, reply.get_error().description());
+}
+
+TEST_F(MethodResultCallback, VoidMethod)
+{
+    EXPECT_TRUE(call("Check", "present"));
+
+    auto reply = call("Check", "absent");
+    ASSERT_FALSE(reply);
+    EXPECT_TRUE(reply.get_error().has_name(NotFound::errName));
+}
+
+TEST_F(MethodResultCallback, ThrownErrorStillCaught)
+{
+    auto reply = call("Check", "throw");
+    ASSERT_FALSE(reply);
+    EXPECT_TRUE(reply.get_error().has_name(NotFound::errName));
+}
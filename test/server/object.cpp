@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
+
+static constexpr auto root = "/xyz/openbmc_project/sdbusplus/test/object";
+
+/** Minimal interface binding, in the shape sdbus++ generates. */
+struct Example
+{
+    Example(sdbusplus::bus::bus& bus, const char* path) :
+        _interface(bus, path, "xyz.openbmc_project.sdbusplus.test.Example",
+                   _vtable, this) {}
+
+    static constexpr sdbusplus::vtable::vtable_t _vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::end()
+    };
+
+    sdbusplus::server::interface_t _interface;
+};
+constexpr sdbusplus::vtable::vtable_t Example::_vtable[];
+
+using Object = sdbusplus::server::object_t<Example>;
+
+class ObjectBatch : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+        sdbusplus::server::manager_t manager{bus, root};
+
+        std::vector<std::string> added;
+        sdbusplus::bus::match_t match{bus,
+            sdbusplus::bus::match::rules::interfacesAdded(),
+            [this](sdbusplus::message::message& m)
+            {
+                sdbusplus::message::object_path p;
+                m.read(p);
+                added.push_back(p.str);
+            }};
+
+        static std::string path(size_t i)
+        {
+            return std::string(root) + "/" + std::to_string(i);
+        }
+
+        void processAll()
+        {
+            for (size_t i = 0; i < 16; ++i)
+            {
+                bus.wait(1000);
+                bus.process_discard();
+            }
+        }
+};
+
+TEST_F(ObjectBatch, SignalsHeldUntilEmit)
+{
+    std::vector<std::unique_ptr<Object>> objects;
+    sdbusplus::server::batch_t b{bus};
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        objects.emplace_back(std::make_unique<Object>(bus, path(i).c_str()));
+    }
+    EXPECT_EQ(3u, b.size());
+
+    processAll();
+    EXPECT_TRUE(added.empty());
+
+    b.emit();
+    EXPECT_EQ(0u, b.size());
+
+    processAll();
+    ASSERT_EQ(3u, added.size());
+    EXPECT_EQ(path(0), added[0]);
+    EXPECT_EQ(path(2), added[2]);
+}
+
+TEST_F(ObjectBatch, EmitsOnDestruction)
+{
+    std::vector<std::unique_ptr<Object>> objects;
+    {
+        sdbusplus::server::batch_t b{bus};
+        objects.emplace_back(std::make_unique<Object>(bus, path(0).c_str()));
+    }
+
+    processAll();
+    EXPECT_EQ(1u, added.size());
+
+    // No batch is active any more, so this one signals immediately.
+    objects.emplace_back(std::make_unique<Object>(bus, path(1).c_str()));
+    processAll();
+    EXPECT_EQ(2u, added.size());
+}
+
+TEST_F(ObjectBatch, DestroyedObjectIsDropped)
+{
+    sdbusplus::server::batch_t b{bus};
+
+    auto o1 = std::make_unique<Object>(bus, path(0).c_str());
+    auto o2 = std::make_unique<Object>(bus, path(1).c_str());
+    o2.reset();
+    EXPECT_EQ(1u, b.size());
+
+    b.emit();
+    processAll();
+    ASSERT_EQ(1u, added.size());
+    EXPECT_EQ(path(0), added[0]);
+}
+
+TEST_F(ObjectBatch, DeferredObjectsAddedExplicitly)
+{
+    sdbusplus::server::batch_t b{bus};
+
+    Object o{bus, path(0).c_str(), true};
+    EXPECT_EQ(0u, b.size());
+
+    b.add(o);
+    b.emit();
+    processAll();
+    EXPECT_EQ(1u, added.size());
+}
+
+TEST_F(ObjectBatch, DestroyedInNestedBatch)
+{
+    sdbusplus::server::batch_t outer{bus};
+    auto o1 = std::make_unique<Object>(bus, path(0).c_str());
+    auto o2 = std::make_unique<Object>(bus, path(1).c_str());
+    EXPECT_EQ(2u, outer.size());
+
+    {
+        sdbusplus::server::batch_t inner{bus};
+        auto o3 = std::make_unique<Object>(bus, path(2).c_str());
+        EXPECT_EQ(1u, inner.size());
+
+        // Removed from the outer batch which holds it, not the active one.
+        o2.reset();
+        EXPECT_EQ(1u, outer.size());
+        EXPECT_EQ(1u, inner.size());
+    }
+
+    // o3 was destroyed before the inner batch, so only o1 is left.
+    outer.emit();
+    processAll();
+    ASSERT_EQ(1u, added.size());
+    EXPECT_EQ(path(0), added[0]);
+}
+
+TEST_F(ObjectBatch, AddedToInactiveBatch)
+{
+    sdbusplus::server::batch_t outer{bus};
+    Object o{bus, path(0).c_str(), true};
+
+    sdbusplus::server::batch_t inner{bus};
+    outer.add(o);
+    EXPECT_EQ(1u, outer.size());
+
+    // Moving the object to another batch removes it from the first.
+    inner.add(o);
+    EXPECT_EQ(0u, outer.size());
+    EXPECT_EQ(1u, inner.size());
+}
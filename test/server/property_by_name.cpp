@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <xyz/openbmc_project/Test/Names/server.hpp>
+
+using Names = sdbusplus::xyz::openbmc_project::Test::server::Names;
+
+class PropertyByName : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+
+        const std::map<std::string, Names::PropertiesVariant> vals = {
+            { "A", uint8_t(1) },
+            { "Sand", int32_t(-2) },
+            { "Sane", true },
+            { "Band", std::string("band") },
+            { "Size", uint64_t(4) },
+            { "Sizes", std::vector<uint64_t>{ 5, 6 } },
+            { "Level", uint32_t(7) },
+            { "Limit", true },
+            { "Levels", std::vector<std::string>{ "eight", "nine" } },
+        };
+};
+
+TEST_F(PropertyByName, RoundTripsEveryProperty)
+{
+    Names names{bus, path, vals};
+
+    for (const auto& v : vals)
+    {
+        EXPECT_TRUE(v.second == names.getPropertyByName(v.first)) << v.first;
+    }
+
+    EXPECT_EQ(1, names.a());
+    EXPECT_EQ(-2, names.sand());
+    EXPECT_TRUE(names.sane());
+    EXPECT_EQ("band", names.band());
+    EXPECT_EQ(4u, names.size());
+    EXPECT_EQ(std::vector<uint64_t>({ 5, 6 }), names.sizes());
+    EXPECT_EQ(7u, names.level());
+    EXPECT_TRUE(names.limit());
+    EXPECT_EQ(std::vector<std::string>({ "eight", "nine" }), names.levels());
+}
+
+TEST_F(PropertyByName, SetsOnlyTheNamedProperty)
+{
+    Names names{bus, path};
+
+    // Sand, Sane and Size share a length and first character, so they are
+    // told apart within the same case of the switch.
+    names.setPropertyByName("Sane", true);
+    EXPECT_TRUE(names.sane());
+    EXPECT_EQ(0, names.sand());
+    EXPECT_EQ(0u, names.size());
+
+    names.setPropertyByName("Size", uint64_t(10));
+    EXPECT_EQ(10u, names.size());
+    EXPECT_EQ(0, names.sand());
+    EXPECT_EQ(0u, names.sizes().size());
+}
+
+TEST_F(PropertyByName, UnknownName)
+{
+    Names names{bus, path, vals};
+
+    // Unknown lengths, unknown characters at the switched position, and a
+    // name which only matches the switch.
+    for (auto name : { "", "B", "Sandy", "Xand", "Sanx", "Levelx", "a" })
+    {
+        EXPECT_TRUE(Names::PropertiesVariant() ==
+                    names.getPropertyByName(name)) << name;
+
+        names.setPropertyByName(name, int32_t(100));
+    }
+
+    for (const auto& v : vals)
+    {
+        EXPECT_TRUE(v.second == names.getPropertyByName(v.first)) << v.first;
+    }
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server.hpp>
+#include <xyz/openbmc_project/Test/ReferenceReturns/server.hpp>
+
+namespace server = sdbusplus::xyz::openbmc_project::Test::server;
+
+static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test/reference";
+static constexpr auto interf = "xyz.openbmc_project.Test.ReferenceReturns";
+
+/** Large enough that a copy of the vector, which allocates exactly its
+ *  size, is told apart from the power-of-two growth of reading it. */
+static constexpr size_t large = 10000;
+
+/** Count allocations the size of a 'large' vector of strings. */
+static std::atomic<bool> counting{false};
+static std::atomic<size_t> copies{0};
+
+void* operator new(size_t size)
+{
+    if (counting && size == large * sizeof(std::string))
+    {
+        ++copies;
+    }
+
+    auto p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/** Accessors generated with --property-returns=reference. */
+using ReferenceReturns =
+        sdbusplus::server::object_t<server::ReferenceReturns>;
+
+class ReferenceReturnsCallback : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) server =
+                sdbusplus::bus::new_default();
+        decltype(sdbusplus::bus::new_default()) client =
+                sdbusplus::bus::new_default();
+
+        ReferenceReturns object{server, path};
+
+        std::string service = server.get_unique_name();
+        std::atomic<bool> stop{false};
+        std::thread thread;
+
+        ~ReferenceReturnsCallback()
+        {
+            stop = true;
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        /** @brief Process the server connection on a thread.
+         *
+         *  The connection is not thread-safe, so the object must not be
+         *  changed locally from then on.
+         */
+        void serve()
+        {
+            thread = std::thread([this]
+                {
+                    while (!stop)
+                    {
+                        server.wait(10000);
+                        server.process_discard();
+                    }
+                });
+        }
+
+        auto properties(const char* method)
+        {
+            return client.new_method_call(service.c_str(), path,
+                                          "org.freedesktop.DBus.Properties",
+                                          method);
+        }
+
+        template <typename T>
+        T get(const char* property)
+        {
+            auto m = properties("Get");
+            m.append(interf, property);
+            auto reply = client.call(m);
+
+            sdbusplus::message::variant<T> value;
+            reply.read(value);
+            return value.template get<T>();
+        }
+};
+
+TEST_F(ReferenceReturnsCallback, ReturnTypes)
+{
+    using names_t = decltype(object.names());
+    using count_t = decltype(object.count());
+
+    static_assert(std::is_same<const std::vector<std::string>&,
+                               names_t>::value,
+                  "Non-trivial properties are returned by reference.");
+    static_assert(std::is_same<uint32_t, count_t>::value,
+                  "Scalar properties are returned by value.");
+}
+
+TEST_F(ReferenceReturnsCallback, ReturnsTheStoredMember)
+{
+    const auto& names = object.names();
+    const auto& set = object.names({ "a", "b" });
+
+    EXPECT_EQ(&names, &set);
+    EXPECT_EQ(&names, &object.names());
+    EXPECT_EQ(std::vector<std::string>({ "a", "b" }), names);
+}
+
+TEST_F(ReferenceReturnsCallback, Get)
+{
+    std::vector<std::string> names{ "one", "two", "three" };
+    std::map<std::string, std::string> assets{ { "tag1", "slot1" },
+                                               { "tag2", "slot2" } };
+
+    object.names(names);
+    object.assets(assets);
+    object.label("label");
+    object.count(3);
+    serve();
+
+    EXPECT_EQ(names, get<std::vector<std::string>>("Names"));
+    EXPECT_EQ(assets, (get<std::map<std::string, std::string>>("Assets")));
+    EXPECT_EQ("label", get<std::string>("Label"));
+    EXPECT_EQ(3u, get<uint32_t>("Count"));
+}
+
+TEST_F(ReferenceReturnsCallback, SetterMovesLargeVector)
+{
+    std::vector<std::string> names(large, "name");
+    auto data = names.data();
+
+    copies = 0;
+    counting = true;
+    object.names(std::move(names));
+    counting = false;
+
+    EXPECT_EQ(0u, copies);
+    EXPECT_EQ(data, object.names().data());
+}
+
+TEST_F(ReferenceReturnsCallback, SetCallbackMovesLargeVector)
+{
+    serve();
+
+    auto m = properties("Set");
+    m.append(interf, "Names",
+             sdbusplus::message::variant<std::vector<std::string>>(
+                     std::vector<std::string>(large, "name")));
+
+    // Neither reading the value in the set callback, nor getting it for
+    // the PropertiesChanged signal, copies the vector.
+    copies = 0;
+    counting = true;
+    client.call(m);
+    counting = false;
+
+    EXPECT_EQ(0u, copies);
+    EXPECT_EQ(large, get<std::vector<std::string>>("Names").size());
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/call_stats.hpp>
+#include <sdbusplus/server/stats.hpp>
+
+class Stats : public ::testing::Test
+{
+    protected:
+        decltype(sdbusplus::bus::new_default()) bus =
+                sdbusplus::bus::new_default();
+        decltype(sdbusplus::bus::new_default()) client =
+                sdbusplus::bus::new_default();
+
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+
+        sdbusplus::server::stats_t stats{bus, path};
+
+        /** Get a property of the stats object from the client. */
+        template <typename T>
+        T get(const char* property)
+        {
+            auto name = bus.get_unique_name();
+
+            std::atomic<bool> done{false};
+            std::thread server([this, &done]()
+                {
+                    while (!done)
+                    {
+                        bus.wait(10000);
+                        bus.process_discard();
+                    }
+                });
+
+            auto m = client.new_method_call(
+                    name.c_str(), path, "org.freedesktop.DBus.Properties",
+                    "Get");
+            m.append(sdbusplus::server::stats::interface_name, property);
+            auto reply = client.call(m);
+
+            done = true;
+            server.join();
+
+            sdbusplus::message::variant<T> value;
+            reply.read(value);
+            return value.template get<T>();
+        }
+};
+
+TEST_F(Stats, Connection)
+{
+    auto c = get<std::map<std::string, uint64_t>>("Connection");
+
+    EXPECT_EQ(15u, c.size());
+    EXPECT_LT(0u, c["ProcessCalls"]);
+    EXPECT_EQ(0u, c["SentCalls"]);
+
+    // The Get call itself is counted by the next one.
+    auto again = get<std::map<std::string, uint64_t>>("Connection");
+    EXPECT_LT(c["ReceivedCalls"], again["ReceivedCalls"]);
+}
+
+TEST_F(Stats, Methods)
+{
+    namespace call_stats = sdbusplus::server::call_stats;
+    static call_stats::site<true> site{"xyz.openbmc_project.Test", "Method",
+                                       call_stats::kind::method};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        call_stats::timer<true> t(site);
+        if (i == 0)
+        {
+            t.failed();
+        }
+    }
+
+    using method = std::tuple<std::string, std::string, std::string,
+                              uint64_t, uint64_t, uint64_t, uint64_t,
+                              uint64_t>;
+    auto methods = get<std::vector<method>>("Methods");
+
+    ASSERT_EQ(1u, methods.size());
+    EXPECT_EQ("xyz.openbmc_project.Test", std::get<0>(methods[0]));
+    EXPECT_EQ("Method", std::get<1>(methods[0]));
+    EXPECT_EQ("method", std::get<2>(methods[0]));
+    EXPECT_EQ(4u, std::get<3>(methods[0]));
+    EXPECT_EQ(1u, std::get<4>(methods[0]));
+    EXPECT_LE(std::get<5>(methods[0]), std::get<6>(methods[0]));
+    EXPECT_LE(std::get<6>(methods[0]), std::get<7>(methods[0]));
+    EXPECT_LT(0u, std::get<7>(methods[0]));
+}
+
+TEST_F(Stats, Matches)
+{
+    auto before = get<uint64_t>("Matches");
+    {
+        sdbusplus::bus::match_t m{bus,
+            sdbusplus::bus::match::rules::nameOwnerChanged(),
+            [](sdbusplus::message::message&) {}};
+
+        EXPECT_EQ(before + 1, get<uint64_t>("Matches"));
+
+        // Moving a match does not count it twice.
+        auto moved = std::move(m);
+        EXPECT_EQ(before + 1, get<uint64_t>("Matches"));
+    }
+    EXPECT_EQ(before, get<uint64_t>("Matches"));
+}
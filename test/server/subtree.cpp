@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/subtree.hpp>
+#include <sdbusplus/vtable.hpp>
+
+class Subtree : public ::testing::Test
+{
+    protected:
+        static constexpr auto prefix = "/xyz/openbmc_project/sdbusplus/test";
+        static constexpr auto interf =
+                "xyz.openbmc_project.sdbusplus.test.Subtree";
+
+        static int getValue(sd_bus*, const char*, const char*,
+                            const char*, sd_bus_message* reply,
+                            void* context, sd_bus_error*)
+        {
+            return sd_bus_message_append_basic(reply, 'i', context);
+        }
+
+        static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+            sdbusplus::vtable::start(),
+            sdbusplus::vtable::property("Value", "i", getValue,
+                sdbusplus::vtable::property_::const_),
+            sdbusplus::vtable::end()
+        };
+
+        /** The objects served by the subtree, keyed by their full path. */
+        std::map<std::string, int32_t> objects = {
+            { std::string(prefix) + "/a", 1 },
+            { std::string(prefix) + "/b", 2 },
+            { std::string(prefix) + "/b/c", 3 },
+        };
+        std::atomic<size_t> lookups{0};
+
+        decltype(sdbusplus::bus::new_default()) server =
+                sdbusplus::bus::new_default();
+        decltype(sdbusplus::bus::new_default()) client =
+                sdbusplus::bus::new_default();
+
+        sdbusplus::server::subtree_t subtree{server, prefix, interf, vtable,
+            [this](const char* path) -> void*
+            {
+                ++lookups;
+                if (std::string(path) == std::string(prefix) + "/throw")
+                {
+                    throw std::runtime_error("lookup failed");
+                }
+                auto i = objects.find(path);
+                return (i == objects.end()) ? nullptr : &i->second;
+            },
+            [this](const char* p)
+            {
+                if (std::string(p) == std::string(prefix) + "/throw")
+                {
+                    throw std::runtime_error("enumeration failed");
+                }
+                std::vector<std::string> paths;
+                for (const auto& o : objects)
+                {
+                    paths.push_back(o.first);
+                }
+                return paths;
+            }};
+
+        std::string service = server.get_unique_name();
+        std::atomic<bool> stop{false};
+        std::thread thread{[this]
+            {
+                while (!stop)
+                {
+                    server.wait(10000);
+                    server.process_discard();
+                }
+            }};
+
+        ~Subtree()
+        {
+            stop = true;
+            thread.join();
+        }
+
+        auto get(const std::string& path)
+        {
+            auto m = client.new_method_call(
+                    service.c_str(), path.c_str(),
+                    "org.freedesktop.DBus.Properties", "Get");
+            m.append(interf, "Value");
+            return client.call(m);
+        }
+
+        auto introspect(const std::string& path)
+        {
+            auto m = client.new_method_call(
+                    service.c_str(), path.c_str(),
+                    "org.freedesktop.DBus.Introspectable", "Introspect");
+
+            std::string xml;
+            auto reply = client.call(m);
+            if (reply)
+            {
+                reply.read(xml);
+            }
+            return xml;
+        }
+};
+
+constexpr sdbusplus::vtable::vtable_t Subtree::vtable[];
+
+TEST_F(Subtree, ResolvesObjectsOnDemand)
+{
+    for (const auto& o : objects)
+    {
+        auto reply = get(o.first);
+        ASSERT_TRUE(bool(reply));
+
+        sdbusplus::message::variant<int32_t> value;
+        reply.read(value);
+        EXPECT_EQ(o.second, value.get<int32_t>());
+    }
+    EXPECT_LE(objects.size(), lookups);
+}
+
+TEST_F(Subtree, UnknownObjectIsAnError)
+{
+    auto reply = get(std::string(prefix) + "/missing");
+    EXPECT_FALSE(bool(reply));
+}
+
+TEST_F(Subtree, EnumeratorListsChildren)
+{
+    auto xml = introspect(prefix);
+    EXPECT_NE(std::string::npos, xml.find("<node name=\"a\"/>"));
+    EXPECT_NE(std::string::npos, xml.find("<node name=\"b\"/>"));
+
+    xml = introspect(std::string(prefix) + "/b");
+    EXPECT_NE(std::string::npos, xml.find("<node name=\"c\"/>"));
+    EXPECT_NE(std::string::npos, xml.find(interf));
+}
+
+TEST_F(Subtree, ThrowingCallbacksFailTheCall)
+{
+    auto reply = get(std::string(prefix) + "/throw");
+    EXPECT_FALSE(bool(reply));
+    EXPECT_EQ("", introspect(std::string(prefix) + "/throw"));
+
+    // The server is still serving.
+    reply = get(std::string(prefix) + "/a");
+    ASSERT_TRUE(bool(reply));
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <systemd/sd-bus.h>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdbusplus/server/transaction.hpp>
+
+namespace transaction = sdbusplus::server::transaction;
+
+class Transaction : public ::testing::Test
+{
+    protected:
+        sd_bus* bus = nullptr;
+        sd_bus* other = nullptr;
+
+        Transaction()
+        {
+            sd_bus_open(&bus);
+            sd_bus_open(&other);
+        }
+
+        ~Transaction()
+        {
+            sd_bus_flush_close_unref(bus);
+            sd_bus_flush_close_unref(other);
+        }
+
+        /** Create a message on a bus, sealed with a given cookie. */
+        sd_bus_message* message(sd_bus* b, uint64_t cookie)
+        {
+            sd_bus_message* m = nullptr;
+            sd_bus_message_new_method_call(b, &m, "org.freedesktop.DBus",
+                                           "/org/freedesktop/DBus",
+                                           "org.freedesktop.DBus", "GetId");
+            sd_bus_message_seal(m, cookie, 0);
+            return m;
+        }
+
+        uint64_t id(sd_bus_message* m)
+        {
+            transaction::set_id_from_message(m);
+            sd_bus_message_unref(m);
+            return transaction::get_id();
+        }
+};
+
+TEST_F(Transaction, SameMessageSameId)
+{
+    auto m = message(bus, 42);
+    transaction::set_id_from_message(m);
+    auto first = transaction::get_id();
+    transaction::set_id(0);
+
+    EXPECT_EQ(first, id(m));
+}
+
+TEST_F(Transaction, IdDependsOnCookie)
+{
+    EXPECT_NE(id(message(bus, 1)), id(message(bus, 2)));
+}
+
+TEST_F(Transaction, IdDependsOnConnection)
+{
+    auto a = id(message(bus, 1));
+    auto b = id(message(other, 1));
+    EXPECT_NE(a, b);
+
+    // Back to the first connection, after the cache moved on.
+    EXPECT_EQ(a, id(message(bus, 1)));
+}
+
+TEST_F(Transaction, NewConnectionIsNotMistakenForFreedOne)
+{
+    sd_bus* first = nullptr;
+    sd_bus_open(&first);
+    auto a = id(message(first, 1));
+    sd_bus_flush_close_unref(first);
+
+    // The new connection will often get the address of the freed one, and
+    // its unique name the address and length of the freed name.
+    sd_bus* second = nullptr;
+    sd_bus_open(&second);
+    auto b = id(message(second, 1));
+    sd_bus_flush_close_unref(second);
+
+    EXPECT_NE(a, b);
+}
+
+class TransactionCall : public Transaction
+{
+    protected:
+        static constexpr auto path = "/xyz/openbmc_project/sdbusplus/test";
+        static constexpr auto interf =
+                "xyz.openbmc_project.sdbusplus.test.Transaction";
+
+        /** The transaction id seen by the server. */
+        static uint64_t served;
+        static std::vector<transaction::call_trace> traces;
+
+        static int method(sd_bus_message* m, void*, sd_bus_error*)
+        {
+            transaction::set_id_from_message(m);
+            served = transaction::get_id();
+            return sd_bus_reply_method_return(m, "");
+        }
+
+        static void tracer(const transaction::call_trace& t)
+        {
+            traces.push_back(t);
+        }
+
+        static constexpr sdbusplus::vtable::vtable_t vtable[] = {
+            sdbusplus::vtable::start(),
+            sdbusplus::vtable::method("Call", "", "", method),
+            sdbusplus::vtable::end()
+        };
+
+        TransactionCall()
+        {
+            served = 0;
+            traces.clear();
+            sd_bus_add_object_vtable(bus, nullptr, path, interf, vtable,
+                                     nullptr);
+        }
+
+        ~TransactionCall()
+        {
+            transaction::set_call_tracer(nullptr);
+        }
+
+        /** Call the server on 'bus' from 'other', serving on a thread. */
+        template <typename Call>
+        void call(Call&& c)
+        {
+            const char* name = nullptr;
+            sd_bus_get_unique_name(bus, &name);
+
+            std::atomic<bool> done{false};
+            std::thread server([this, &done]()
+                {
+                    while (!done)
+                    {
+                        sd_bus_wait(bus, 10000);
+                        while (sd_bus_process(bus, nullptr) > 0);
+                    }
+                });
+
+            sdbusplus::bus::bus caller{other};
+            auto m = caller.new_method_call(name, path, interf, "Call");
+            c(caller, m);
+
+            done = true;
+            server.join();
+        }
+};
+
+uint64_t TransactionCall::served = 0;
+std::vector<transaction::call_trace> TransactionCall::traces;
+constexpr sdbusplus::vtable::vtable_t TransactionCall::vtable[];
+
+TEST_F(TransactionCall, ServerAdoptsCallerId)
+{
+    transaction::set_call_tracer(tracer);
+    transaction::set_id(1234);
+
+    call([](sdbusplus::bus::bus& b, sdbusplus::message::message& m)
+        {
+            b.call(m);
+        });
+
+    ASSERT_EQ(1u, traces.size());
+    EXPECT_EQ(1234u, traces[0].parent);
+    EXPECT_NE(0u, served);
+    EXPECT_EQ(served, traces[0].child);
+    EXPECT_LE(traces[0].start, traces[0].end);
+    EXPECT_EQ(1234u, transaction::get_id());
+}
+
+TEST_F(TransactionCall, NoReplyIsTraced)
+{
+    transaction::set_call_tracer(tracer);
+
+    call([](sdbusplus::bus::bus& b, sdbusplus::message::message& m)
+        {
+            b.call_noreply(m);
+        });
+
+    ASSERT_EQ(1u, traces.size());
+    EXPECT_EQ(served, traces[0].child);
+}
+
+TEST_F(TransactionCall, NotTracedWithoutTracer)
+{
+    call([](sdbusplus::bus::bus& b, sdbusplus::message::message& m)
+        {
+            b.call(m);
+        });
+
+    EXPECT_NE(0u, served);
+    EXPECT_TRUE(traces.empty());
+}
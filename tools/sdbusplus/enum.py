@@ -9,3 +9,7 @@ class Enum(NamedElement):
             [Property(**v) for v in kwargs.pop('values', [])]
 
         super(Enum, self).__init__(**kwargs)
+
+    def value_switch(self):
+        """ Group the values for a 'switch' on their names. """
+        return NamedElement.name_switch(self.values)
@@ -29,9 +29,24 @@ class Interface(NamedElement, Renderer):
             [Signal(**s) for s in kwargs.pop('signals', [])]
         self.enums = \
             [Enum(**e) for e in kwargs.pop('enumerations', [])]
+        # Code generation options; chosen by the sdbus++ caller, not the YAML.
+        self.accessors = 'virtual'
+        self.returns = 'value'
+        self.method_errors = 'exception'
 
         super(Interface, self).__init__(**kwargs)
 
+    def property_return_type(self, p):
+        """ The type returned by the accessors of a property. """
+        t = p.cppTypeParam(self.name)
+        if self.returns == 'reference' and not p.is_trivial():
+            return "const %s&" % t
+        return t
+
+    def property_switch(self):
+        """ Group the properties for a 'switch' on their names. """
+        return NamedElement.name_switch(self.properties)
+
     def markdown(self, loader):
         return self.render(loader, "interface.mako.md", interface=self)
 
@@ -21,6 +21,36 @@ class NamedElement(object):
             raise AttributeError("Attribute '%s' not found in %s.NamedElement"
                                  % (name, self.__module__))
 
+    @staticmethod
+    def name_switch(elements):
+        """ Group elements for a two-level 'switch' on their names.
+
+            Elements are grouped by name length and, within a length, by
+            the character at the position which best tells the names of
+            that length apart, so a lookup costs two jumps and, typically,
+            a single string compare no matter how many elements there are.
+
+            Returns a list of (length, index, [(char, [element])]).
+        """
+        by_length = {}
+        for e in elements:
+            by_length.setdefault(len(e.name), []).append(e)
+
+        result = []
+        for length in sorted(by_length):
+            group = by_length[length]
+            index = max(range(length),
+                        key=lambda i: (len(set(e.name[i] for e in group)), -i))
+
+            by_char = {}
+            for e in group:
+                by_char.setdefault(e.name[index], []).append(e)
+
+            result.append((length, index,
+                           [(c, by_char[c]) for c in sorted(by_char)]))
+
+        return result
+
     """ Some names are reserved in some languages.  Fixup names to avoid using
         reserved words.
     """
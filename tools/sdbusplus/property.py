@@ -8,6 +8,9 @@ class Property(NamedElement, Renderer):
         self.typeName = kwargs.pop('type', None)
         self.cppTypeName = self.parse_cpp_type(self.typeName)
         self.defaultValue = kwargs.pop('default', None)
+        self.flags = self.parse_flags(kwargs.pop('flags', ['emits_change']))
+        self.changePolicy = self.parse_change_policy(
+            kwargs.pop('change_policy', None))
 
         super(Property, self).__init__(**kwargs)
 
@@ -18,6 +21,77 @@ class Property(NamedElement, Renderer):
             return True
         return False
 
+    """ Scalars and enums are cheap to copy, so they are always passed and
+        returned by value.
+    """
+    def is_trivial(self):
+        if self.is_enum():
+            return True
+        return self.typeName in ['byte', 'boolean', 'int16', 'uint16',
+                                 'int32', 'uint32', 'int64', 'uint64',
+                                 'double']
+
+    """ Validate the optional 'flags' of a property, which select how
+        changes are signalled: 'emits_change' (the default) sends the new
+        value, 'emits_invalidation' only the name, 'const' marks the
+        property as never changing and 'none' sends nothing.
+    """
+    def parse_flags(self, flags):
+        if not isinstance(flags, list):
+            flags = [flags]
+
+        known = ['const', 'emits_change', 'emits_invalidation', 'none']
+        unknown = [f for f in flags if f not in known]
+        if unknown or len(flags) != 1:
+            raise RuntimeError("Property flags must be one of %s, not %s"
+                               % (known, flags))
+
+        return flags
+
+    """ Return the sdbusplus::vtable::property_ flags for the property. """
+    def vtable_flags(self):
+        return {'const': 'vtable::property_::const_',
+                'emits_change': 'vtable::property_::emits_change',
+                'emits_invalidation': 'vtable::property_::emits_invalidation',
+                'none': '0'}[self.flags[0]]
+
+    """ Constant properties are registered as read-only. """
+    def is_writable(self):
+        return 'const' not in self.flags
+
+    def emits_signal(self):
+        return self.flags[0] in ['emits_change', 'emits_invalidation']
+
+    """ Validate the optional 'change_policy' of a property and convert it
+        to the (absolute, relative, interval in usec) arguments of
+        sdbusplus::server::change_policy_t.
+    """
+    def parse_change_policy(self, policy):
+        if policy is None:
+            return None
+
+        if not self.emits_signal():
+            raise RuntimeError("change_policy requires a signalling property")
+
+        if self.is_enum() or not self.is_trivial() or \
+                self.typeName == 'boolean':
+            raise RuntimeError("change_policy requires a numeric type, not %s"
+                               % self.typeName)
+
+        unknown = set(policy) - {'deadband', 'relative_deadband',
+                                 'min_interval_ms'}
+        if unknown:
+            raise RuntimeError("Unknown change_policy keys %s"
+                               % sorted(unknown))
+
+        result = {'absolute': float(policy.get('deadband', 0)),
+                  'relative': float(policy.get('relative_deadband', 0)),
+                  'interval': int(policy.get('min_interval_ms', 0)) * 1000}
+        if min(result.values()) < 0:
+            raise RuntimeError("change_policy values must not be negative")
+
+        return result
+
     """ Return a conversion of the cppTypeName valid as a function parameter.
         Currently only 'enum' requires conversion.
     """
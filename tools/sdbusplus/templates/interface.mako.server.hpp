@@ -2,6 +2,12 @@
 #include <tuple>
 #include <systemd/sd-bus.h>
 #include <sdbusplus/server.hpp>
+% if any(p.changePolicy for p in interface.properties):
+#include <sdbusplus/server/change_policy.hpp>
+% endif
+% if interface.method_errors == 'result' and interface.methods:
+#include <sdbusplus/server/method_result.hpp>
+% endif
 <%
     namespaces = interface.name.split('.')
     classname = namespaces.pop()
@@ -9,6 +15,11 @@
     def setOfPropertyTypes():
         return set(p.cppTypeParam(interface.name) for p in
                    interface.properties);
+
+    def accessor_specifier():
+        # 'final' accessors cannot be overridden, which lets the compiler
+        # call (and inline) them directly from the sd-bus callbacks.
+        return " final" if interface.accessors == 'final' else ""
 %>
 namespace sdbusplus
 {
@@ -78,10 +89,16 @@ ${ s.cpp_prototype(loader, interface=interface, ptype='header') }
 
     % for p in interface.properties:
         /** Get value of ${p.name} */
-        virtual ${p.cppTypeParam(interface.name)} ${p.camelCase}() const;
+        virtual ${interface.property_return_type(p)} ${p.camelCase}() const\
+${accessor_specifier()};
         /** Set value of ${p.name} */
-        virtual ${p.cppTypeParam(interface.name)} \
-${p.camelCase}(${p.cppTypeParam(interface.name)} value);
+        virtual ${interface.property_return_type(p)} \
+${p.camelCase}(${p.cppTypeParam(interface.name)} value)${accessor_specifier()};
+        /** Set value of ${p.name}, optionally without signalling the change
+         *  until a later emitChanged().  The change still goes through the
+         *  setter above, so overrides of it and change policies apply. */
+        ${interface.property_return_type(p)} \
+${p.camelCase}(${p.cppTypeParam(interface.name)} value, bool skipSignal);
     % endfor
 
     % if interface.properties:
@@ -98,6 +115,32 @@ ${p.camelCase}(${p.cppTypeParam(interface.name)} value);
          */
         PropertiesVariant getPropertyByName(const std::string& name);
 
+        /** @brief Enable or disable coalescing of PropertiesChanged signals.
+         *
+         *  While enabled, changed properties are accumulated and sent as a
+         *  single PropertiesChanged signal at the end of the current event
+         *  loop iteration, or on flushPropertyChanges().
+         *
+         *  @param[in] enable - True to coalesce, false to signal immediately.
+         */
+        void coalescePropertyChanges(bool enable);
+
+        /** @brief Send any accumulated PropertiesChanged signal now. */
+        void flushPropertyChanges();
+
+        /** @brief Send one PropertiesChanged signal for the properties which
+         *         were set with 'skipSignal' and changed since they were last
+         *         signalled.
+         *
+         *  @param[in] names - The property names, or none for all of them.
+         */
+        template <typename... Names>
+        void emitChanged(const Names&... names)
+        {
+            _${"_".join(interface.name.split('.'))}_interface.emit_changed(
+                    names...);
+        }
+
     % endif
     % for e in interface.enums:
     /** @brief Convert a string to an appropriate enum value.
@@ -118,10 +161,12 @@ ${ m.cpp_prototype(loader, interface=interface, ptype='callback-header') }
         static int _callback_get_${p.name}(
             sd_bus*, const char*, const char*, const char*,
             sd_bus_message*, void*, sd_bus_error*);
+        % if p.is_writable():
         /** @brief sd-bus callback for set-property '${p.name}' */
         static int _callback_set_${p.name}(
             sd_bus*, const char*, const char*, const char*,
             sd_bus_message*, void*, sd_bus_error*);
+        % endif
 
     % endfor
 
@@ -142,6 +187,18 @@ ${p.defaultValue};
         % endif
     % endfor
 
+    % for p in interface.properties:
+        % if p.changePolicy:
+        /** Deadband and rate limit for the '${p.name}' signal. */
+        sdbusplus::server::change_policy_t<${p.cppTypeParam(interface.name)}>
+                _policy_${p.name}{
+                    _${"_".join(interface.name.split('.'))}_interface,
+                    "${p.name}", _${p.camelCase},
+                    ${p.changePolicy['absolute']}, \
+${p.changePolicy['relative']}, ${p.changePolicy['interval']}};
+        % endif
+    % endfor
+
 };
 
     % for e in interface.enums:
@@ -153,7 +210,7 @@ ${p.defaultValue};
  * @param[in] e - Enum value to convert.
  * @return C-string representing the name for the enum value.
  */
-std::string convertForMessage(${classname}::${e.name} e);
+const char* convertForMessage(${classname}::${e.name} e);
     % endfor
 
 } // namespace server
@@ -47,8 +47,8 @@
 ###
     % elif ptype == 'vtable':
     vtable::signal("${signal.name}",
-                   details::${interface_name()}::_signal_${signal.CamelCase }
-                        .data()),
+                   &details::${interface_name()}::
+                        _signal_${signal.CamelCase }[0]),
 ###
 ### Emit 'callback-cpp'
 ###
@@ -69,7 +69,7 @@ namespace details
 {
 namespace ${interface_name()}
 {
-static const auto _signal_${ signal.CamelCase } =
+static constexpr auto _signal_${ signal.CamelCase } =
     % if len(signal.properties) == 0:
         utility::tuple_to_array(std::make_tuple('\0'));
     % else: